@@ -1,20 +1,26 @@
+# Set ACSS_MODULES before including this file to select the libraries to
+# link. Available modules are core, widgets and qml. The default is
+# core and widgets.
+isEmpty(ACSS_MODULES) {
+    ACSS_MODULES = core widgets
+}
 
+ACSS_LIB_SUFFIX =
 CONFIG(debug, debug|release){
     win32 {
-    	versionAtLeast(QT_VERSION, 5.15.0) {
-    		LIBS += -lqtadvancedcss
-    	}
-    	else {
-    		LIBS += -lqtadvancedcssd
+    	!versionAtLeast(QT_VERSION, 5.15.0) {
+    		ACSS_LIB_SUFFIX = d
     	}
     }
     else:mac {
-        LIBS += -lqtadvancedcss_debug
-    }
-    else {
-        LIBS += -lqtadvancedcss
+        ACSS_LIB_SUFFIX = _debug
     }
 }
-else{
-    LIBS += -lqtadvancedcss
+
+contains(ACSS_MODULES, qml) {
+    LIBS += -lqtadvancedcssqml$${ACSS_LIB_SUFFIX}
+}
+contains(ACSS_MODULES, widgets) {
+    LIBS += -lqtadvancedcss$${ACSS_LIB_SUFFIX}
 }
+LIBS += -lqtadvancedcsscore$${ACSS_LIB_SUFFIX}
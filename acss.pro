@@ -2,7 +2,11 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
 	src \
-	examples
+	examples \
+	benchmarks \
+	tests
 
 #demo.depends = src
-examples.depends = src
\ No newline at end of file
+examples.depends = src
+benchmarks.depends = src
+tests.depends = src
@@ -0,0 +1,318 @@
+#include <ColorBatch.h>
+#include <StyleCache.h>
+#include <StyleProcessor.h>
+#include <StyleTemplate.h>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+
+using namespace acss;
+
+#define _STR(x) #x
+#define STRINGIFY(x)  _STR(x)
+
+/**
+ * Runs the given function Iterations times and returns the median and the
+ * minimum execution time in milliseconds
+ */
+static QJsonObject measure(int Iterations, const std::function<void()>& Function)
+{
+	QVector<double> Times;
+	for (int i = 0; i < Iterations; ++i)
+	{
+		QElapsedTimer Timer;
+		Timer.start();
+		Function();
+		Times.append(Timer.nsecsElapsed() / 1000000.0);
+	}
+	std::sort(Times.begin(), Times.end());
+
+	QJsonObject jResult;
+	jResult.insert("iterations", Iterations);
+	jResult.insert("median_ms", Times.isEmpty() ? 0.0 : Times.at(Times.size() / 2));
+	jResult.insert("min_ms", Times.isEmpty() ? 0.0 : Times.first());
+	return jResult;
+}
+
+
+/**
+ * Returns the machine and build configuration the benchmarks run on
+ */
+static QJsonObject environment(const QString& ConfigLabel)
+{
+	QJsonObject jEnvironment;
+	jEnvironment.insert("host", QSysInfo::machineHostName());
+	jEnvironment.insert("cpu", QSysInfo::currentCpuArchitecture());
+	jEnvironment.insert("os", QSysInfo::prettyProductName());
+	jEnvironment.insert("cores", QThread::idealThreadCount());
+	jEnvironment.insert("qt", QString(qVersion()));
+#ifdef QT_DEBUG
+	jEnvironment.insert("build", QString("debug"));
+#else
+	jEnvironment.insert("build", QString("release"));
+#endif
+	jEnvironment.insert("config", ConfigLabel);
+	return jEnvironment;
+}
+
+
+/**
+ * Returns the baseline key for the given environment.
+ * Benchmarks are only comparable on the same machine with the same build
+ * configuration.
+ */
+static QString baselineKey(const QJsonObject& Environment)
+{
+	QStringList Parts;
+	for (const auto& Key : {"host", "cpu", "qt", "build", "config"})
+	{
+		auto Value = Environment.value(Key).toString();
+		if (!Value.isEmpty())
+		{
+			Parts.append(Value);
+		}
+	}
+	return Parts.join('_').replace(QRegularExpression("[^A-Za-z0-9_.-]"), "-");
+}
+
+
+/**
+ * Runs all pipeline benchmarks for the given style and themes
+ */
+static QJsonObject runBenchmarks(const QString& Style, int Iterations,
+	const QString& OutputDir)
+{
+	QJsonObject jBenchmarks;
+	CStyleProcessor Processor;
+	Processor.setStylesDirPath(STRINGIFY(STYLES_DIR));
+	Processor.setOutputDirPath(OutputDir);
+
+	jBenchmarks.insert("setCurrentStyle", measure(Iterations, [&]()
+	{
+		Processor.setCurrentStyle(Style);
+	}));
+
+	auto Themes = Processor.themes();
+	if (Themes.isEmpty())
+	{
+		return jBenchmarks;
+	}
+
+	// One transition frame between the colors of two themes
+	Processor.setCurrentTheme(Themes.first());
+	auto FromColors = Processor.themeColorVariables();
+	Processor.setCurrentTheme(Themes.last());
+	auto ToColors = Processor.themeColorVariables();
+	jBenchmarks.insert("color_interpolate", measure(Iterations, [&]()
+	{
+		CColorBatch::interpolateColors(FromColors, ToColors, 0.5f);
+	}));
+
+	int ThemeIndex = 0;
+	auto nextTheme = [&]()
+	{
+		Processor.setCurrentTheme(Themes.at(ThemeIndex++ % Themes.size()));
+	};
+	jBenchmarks.insert("setCurrentTheme", measure(Iterations, nextTheme));
+
+	// Parses all theme files of the style once
+	jBenchmarks.insert("theme_catalog", measure(Iterations, [&]()
+	{
+		for (const auto& Theme : Themes)
+		{
+			Processor.setCurrentTheme(Theme);
+		}
+	}));
+
+	// Without the artifact cache, each update generates all artifacts
+	Processor.artifactCache().setBudget(0);
+	jBenchmarks.insert("updateStylesheet_cold", measure(Iterations, [&]()
+	{
+		nextTheme();
+		Processor.updateStylesheet();
+	}));
+
+	// With a cache that holds all themes, switching only writes the files
+	Processor.artifactCache().setBudget(256 * 1024 * 1024);
+	for (int i = 0; i < Themes.size(); ++i)
+	{
+		nextTheme();
+		Processor.updateStylesheet();
+	}
+	jBenchmarks.insert("updateStylesheet_warm", measure(Iterations, [&]()
+	{
+		nextTheme();
+		Processor.updateStylesheet();
+	}));
+
+	auto CssTemplateFile = Processor.styleParameters().value("css_template").toString();
+	QFile TemplateFile(Processor.currentStylePath() + "/" + CssTemplateFile);
+	if (CssTemplateFile.isEmpty() || !TemplateFile.open(QIODevice::ReadOnly))
+	{
+		return jBenchmarks;
+	}
+
+	auto TemplateContent = TemplateFile.readAll();
+	CStyleTemplate Template;
+	// A large combined template of base style, product and plugin sections
+	QByteArray LargeTemplate;
+	for (int i = 0; i < 16; ++i)
+	{
+		LargeTemplate += TemplateContent;
+	}
+	jBenchmarks.insert("template_compile_large", measure(Iterations, [&]()
+	{
+		Template.compile(LargeTemplate);
+	}));
+
+	jBenchmarks.insert("template_compile", measure(Iterations, [&]()
+	{
+		Template.compile(TemplateContent);
+	}));
+
+	QMap<QString, QString> Variables = Processor.themeColorVariables();
+	jBenchmarks.insert("template_render", measure(Iterations, [&]()
+	{
+		Template.render(Variables);
+	}));
+	return jBenchmarks;
+}
+
+
+/**
+ * Parses the per benchmark thresholds given as name=percent
+ */
+static QMap<QString, double> parseThresholds(const QStringList& Values)
+{
+	QMap<QString, double> Thresholds;
+	for (const auto& Value : Values)
+	{
+		auto Parts = Value.split('=');
+		if (Parts.size() == 2)
+		{
+			Thresholds.insert(Parts[0].trimmed(), Parts[1].toDouble());
+		}
+	}
+	return Thresholds;
+}
+
+
+/**
+ * Compares the given results with the baseline and prints a report.
+ * Returns the number of regressions.
+ */
+static int compareWithBaseline(const QJsonObject& Baseline, const QJsonObject& Current,
+	double DefaultThreshold, const QMap<QString, double>& Thresholds)
+{
+	auto jBaseline = Baseline.value("benchmarks").toObject();
+	auto jCurrent = Current.value("benchmarks").toObject();
+	int Regressions = 0;
+	std::cout << QString("%1 %2 %3 %4 %5  %6").arg("benchmark", -24)
+		.arg("baseline", 10).arg("current", 10).arg("change", 9)
+		.arg("limit", 7).arg("status").toStdString() << std::endl;
+	for (auto itc = jCurrent.constBegin(); itc != jCurrent.constEnd(); ++itc)
+	{
+		auto CurrentMs = itc.value().toObject().value("median_ms").toDouble();
+		auto Threshold = Thresholds.value(itc.key(), DefaultThreshold);
+		if (!jBaseline.contains(itc.key()))
+		{
+			std::cout << QString("%1 %2 %3 %4 %5  %6").arg(itc.key(), -24)
+				.arg("-", 10).arg(CurrentMs, 10, 'f', 3).arg("-", 9)
+				.arg(Threshold, 6, 'f', 1).arg("new").toStdString() << std::endl;
+			continue;
+		}
+
+		auto BaselineMs = jBaseline.value(itc.key()).toObject().value("median_ms").toDouble();
+		double Change = (BaselineMs > 0) ? (CurrentMs - BaselineMs) * 100.0 / BaselineMs : 0;
+		bool Regression = Change > Threshold;
+		if (Regression)
+		{
+			Regressions++;
+		}
+		std::cout << QString("%1 %2 %3 %4% %5%  %6").arg(itc.key(), -24)
+			.arg(BaselineMs, 10, 'f', 3).arg(CurrentMs, 10, 'f', 3)
+			.arg(Change, 8, 'f', 1).arg(Threshold, 6, 'f', 1)
+			.arg(Regression ? "REGRESSION" : "ok").toStdString() << std::endl;
+	}
+	return Regressions;
+}
+
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication a(argc, argv);
+	QString AppDir = qApp->applicationDirPath();
+
+	QCommandLineParser Parser;
+	Parser.setApplicationDescription("Runs the style pipeline benchmarks and "
+		"compares the results with a stored baseline");
+	Parser.addHelpOption();
+	QCommandLineOption StyleOption("style", "The style to benchmark", "style", "qt_material");
+	QCommandLineOption IterationsOption("iterations", "Number of iterations "
+		"per benchmark", "count", "20");
+	QCommandLineOption BaselineDirOption("baseline-dir", "Directory with the "
+		"baselines", "dir", AppDir + "/baselines");
+	QCommandLineOption ConfigOption("config", "Label of the build "
+		"configuration that is part of the baseline key", "label");
+	QCommandLineOption SaveOption("save", "Store the results as new baseline");
+	QCommandLineOption ThresholdOption("threshold", "Allowed slowdown in "
+		"percent", "percent", "10");
+	QCommandLineOption BenchmarkThresholdOption("benchmark-threshold", "Allowed "
+		"slowdown for a single benchmark, i.e. template_render=25", "name=percent");
+	Parser.addOptions({StyleOption, IterationsOption, BaselineDirOption,
+		ConfigOption, SaveOption, ThresholdOption, BenchmarkThresholdOption});
+	Parser.process(a);
+
+	QJsonObject jResults;
+	auto jEnvironment = environment(Parser.value(ConfigOption));
+	jResults.insert("environment", jEnvironment);
+	jResults.insert("benchmarks", runBenchmarks(Parser.value(StyleOption),
+		std::max(1, Parser.value(IterationsOption).toInt()), AppDir + "/bench_output"));
+
+	QDir().mkpath(Parser.value(BaselineDirOption));
+	auto BaselineFileName = Parser.value(BaselineDirOption) + "/"
+		+ baselineKey(jEnvironment) + ".json";
+	if (Parser.isSet(SaveOption))
+	{
+		QFile BaselineFile(BaselineFileName);
+		if (!BaselineFile.open(QIODevice::WriteOnly))
+		{
+			std::cerr << "Error writing baseline " << BaselineFileName.toStdString() << std::endl;
+			return 1;
+		}
+		BaselineFile.write(QJsonDocument(jResults).toJson());
+		std::cout << "Baseline written to " << BaselineFileName.toStdString() << std::endl;
+		return 0;
+	}
+
+	QFile BaselineFile(BaselineFileName);
+	if (!BaselineFile.open(QIODevice::ReadOnly))
+	{
+		std::cout << QJsonDocument(jResults).toJson().constData();
+		std::cerr << "No baseline " << BaselineFileName.toStdString()
+			<< " - run with --save to create it" << std::endl;
+		return 0;
+	}
+
+	auto Baseline = QJsonDocument::fromJson(BaselineFile.readAll()).object();
+	auto Regressions = compareWithBaseline(Baseline, jResults,
+		Parser.value(ThresholdOption).toDouble(),
+		parseThresholds(Parser.values(BenchmarkThresholdOption)));
+	if (Regressions)
+	{
+		std::cerr << Regressions << " benchmark(s) regressed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,255 @@
+#include <StyleManager.h>
+#include <QApplication>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QCommandLineParser>
+#include <QDockWidget>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFormLayout>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLineEdit>
+#include <QMainWindow>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QStandardItemModel>
+#include <QTabWidget>
+#include <QTableView>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace acss;
+
+#define _STR(x) #x
+#define STRINGIFY(x)  _STR(x)
+
+/**
+ * Size of the synthetic widget tree
+ */
+struct WorkloadSize
+{
+	int Docks = 4;
+	int Views = 2;
+	int Rows = 100;
+	int Tabs = 4;
+	int Forms = 4;
+};
+
+
+/**
+ * Creates a form with a number of typical input widgets
+ */
+static QWidget* createForm(int Index)
+{
+	auto Form = new QWidget();
+	auto Layout = new QFormLayout(Form);
+	Layout->addRow("Name", new QLineEdit(QString("Item %1").arg(Index)));
+	auto Combo = new QComboBox();
+	Combo->addItems({"Option A", "Option B", "Option C"});
+	Layout->addRow("Type", Combo);
+	Layout->addRow("Count", new QSpinBox());
+	Layout->addRow("Enabled", new QCheckBox());
+	Layout->addRow(new QPushButton("Apply"));
+	return Form;
+}
+
+
+/**
+ * Creates an item view with the given number of rows
+ */
+static QWidget* createView(int Rows, QObject* ModelParent)
+{
+	auto Model = new QStandardItemModel(Rows, 4, ModelParent);
+	for (int Row = 0; Row < Rows; ++Row)
+	{
+		for (int Column = 0; Column < 4; ++Column)
+		{
+			Model->setItem(Row, Column, new QStandardItem(
+				QString("Cell %1/%2").arg(Row).arg(Column)));
+		}
+	}
+	auto View = new QTableView();
+	View->setModel(Model);
+	return View;
+}
+
+
+/**
+ * Builds the main window with the synthetic widget tree
+ */
+static QMainWindow* createWorkload(const WorkloadSize& Size)
+{
+	auto Window = new QMainWindow();
+	auto Tabs = new QTabWidget();
+	for (int i = 0; i < Size.Tabs; ++i)
+	{
+		auto Page = new QWidget();
+		auto Layout = new QVBoxLayout(Page);
+		for (int j = i; j < Size.Forms; j += std::max(1, Size.Tabs))
+		{
+			Layout->addWidget(createForm(j));
+		}
+		Tabs->addTab(Page, QString("Tab %1").arg(i));
+	}
+
+	auto Central = new QWidget();
+	auto CentralLayout = new QVBoxLayout(Central);
+	CentralLayout->addWidget(Tabs);
+	for (int i = 0; i < Size.Views; ++i)
+	{
+		CentralLayout->addWidget(createView(Size.Rows, Window));
+	}
+	Window->setCentralWidget(Central);
+
+	for (int i = 0; i < Size.Docks; ++i)
+	{
+		auto Dock = new QDockWidget(QString("Dock %1").arg(i), Window);
+		Dock->setWidget(createForm(i));
+		Window->addDockWidget((i % 2) ? Qt::RightDockWidgetArea : Qt::LeftDockWidgetArea, Dock);
+	}
+	return Window;
+}
+
+
+/**
+ * Measures one theme switch and returns the stage timings in milliseconds
+ */
+static QJsonObject switchTheme(CStyleManager& StyleManager, QWidget* Window,
+	const QString& Theme)
+{
+	static const double NsPerMs = 1000000.0;
+	QJsonObject jResult;
+	jResult.insert("theme", Theme);
+	QElapsedTimer Timer;
+	Timer.start();
+	StyleManager.setCurrentTheme(Theme);
+	jResult.insert("set_theme_ms", Timer.nsecsElapsed() / NsPerMs);
+
+	Timer.restart();
+	StyleManager.updateStylesheet();
+	jResult.insert("update_stylesheet_ms", Timer.nsecsElapsed() / NsPerMs);
+
+	Timer.restart();
+	qApp->setStyleSheet(StyleManager.styleSheet());
+	jResult.insert("apply_stylesheet_ms", Timer.nsecsElapsed() / NsPerMs);
+
+	// Deliver the pending polish and layout events and paint the window
+	Timer.restart();
+	QApplication::processEvents();
+	Window->repaint();
+	jResult.insert("first_repaint_ms", Timer.nsecsElapsed() / NsPerMs);
+	return jResult;
+}
+
+
+int main(int argc, char *argv[])
+{
+	// The benchmark runs headless by default
+	if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+	{
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication a(argc, argv);
+	QString AppDir = qApp->applicationDirPath();
+
+	QCommandLineParser Parser;
+	Parser.setApplicationDescription("Measures the theme switch costs for a "
+		"configurable synthetic widget tree");
+	Parser.addHelpOption();
+	QCommandLineOption StyleOption("style", "The style to use", "style", "qt_material");
+	QCommandLineOption DocksOption("docks", "Number of dock widgets", "count", "4");
+	QCommandLineOption ViewsOption("views", "Number of item views", "count", "2");
+	QCommandLineOption RowsOption("rows", "Number of rows per item view", "count", "100");
+	QCommandLineOption TabsOption("tabs", "Number of tabs", "count", "4");
+	QCommandLineOption FormsOption("forms", "Number of forms in the tabs", "count", "4");
+	QCommandLineOption IterationsOption("iterations", "Number of theme "
+		"switches", "count", "10");
+	QCommandLineOption OutputOption("output", "The JSON result file", "file");
+	Parser.addOptions({StyleOption, DocksOption, ViewsOption, RowsOption,
+		TabsOption, FormsOption, IterationsOption, OutputOption});
+	Parser.process(a);
+
+	WorkloadSize Size;
+	Size.Docks = Parser.value(DocksOption).toInt();
+	Size.Views = Parser.value(ViewsOption).toInt();
+	Size.Rows = Parser.value(RowsOption).toInt();
+	Size.Tabs = Parser.value(TabsOption).toInt();
+	Size.Forms = Parser.value(FormsOption).toInt();
+
+	CStyleManager StyleManager;
+	StyleManager.setStylesDirPath(STRINGIFY(STYLES_DIR));
+	StyleManager.setOutputDirPath(AppDir + "/bench_output");
+	StyleManager.setCurrentStyle(Parser.value(StyleOption));
+	auto Themes = StyleManager.themes();
+	if (Themes.isEmpty())
+	{
+		std::cerr << "Style " << Parser.value(StyleOption).toStdString()
+			<< " has no themes" << std::endl;
+		return 1;
+	}
+
+	QElapsedTimer Timer;
+	Timer.start();
+	auto Window = createWorkload(Size);
+	Window->resize(1600, 1200);
+	Window->show();
+	QApplication::processEvents();
+	auto BuildMs = Timer.nsecsElapsed() / 1000000.0;
+	auto WidgetCount = Window->findChildren<QWidget*>().size() + 1;
+
+	QJsonArray jSwitches;
+	int Iterations = std::max(1, Parser.value(IterationsOption).toInt());
+	for (int i = 0; i < Iterations; ++i)
+	{
+		auto jSwitch = switchTheme(StyleManager, Window, Themes.at(i % Themes.size()));
+		jSwitches.append(jSwitch);
+		std::cout << QJsonDocument(jSwitch).toJson(QJsonDocument::Compact).constData() << std::endl;
+	}
+
+	// The first switch polishes all widgets for the first time, so the
+	// median is used for the summary
+	QJsonObject jSummary;
+	for (const auto& Key : {"set_theme_ms", "update_stylesheet_ms",
+		"apply_stylesheet_ms", "first_repaint_ms"})
+	{
+		QVector<double> Values;
+		for (const auto& Switch : jSwitches)
+		{
+			Values.append(Switch.toObject().value(Key).toDouble());
+		}
+		std::sort(Values.begin(), Values.end());
+		jSummary.insert(Key, Values.at(Values.size() / 2));
+	}
+
+	QJsonObject jResult;
+	jResult.insert("platform", QApplication::platformName());
+	jResult.insert("widgets", WidgetCount);
+	jResult.insert("build_ms", BuildMs);
+	jResult.insert("docks", Size.Docks);
+	jResult.insert("views", Size.Views);
+	jResult.insert("rows", Size.Rows);
+	jResult.insert("tabs", Size.Tabs);
+	jResult.insert("forms", Size.Forms);
+	jResult.insert("median", jSummary);
+	jResult.insert("switches", jSwitches);
+	std::cout << "widgets: " << WidgetCount << std::endl
+		<< QJsonDocument(jSummary).toJson().constData();
+
+	if (Parser.isSet(OutputOption))
+	{
+		QFile OutputFile(Parser.value(OutputOption));
+		if (!OutputFile.open(QIODevice::WriteOnly))
+		{
+			std::cerr << "Error writing " << Parser.value(OutputOption).toStdString() << std::endl;
+			return 1;
+		}
+		OutputFile.write(QJsonDocument(jResult).toJson());
+	}
+
+	delete Window;
+	return 0;
+}
@@ -0,0 +1,29 @@
+ACSS_OUT_ROOT = $${OUT_PWD}/../..
+
+QT += core gui widgets
+
+
+TARGET = widget_bench
+DESTDIR = $${ACSS_OUT_ROOT}/lib
+TEMPLATE = app
+
+CONFIG += c++14
+CONFIG += debug_and_release
+CONFIG += console 
+
+acssBuildStatic {
+    DEFINES += ACSS_STATIC
+}
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += widget_bench.cpp
+
+DEFINES += "STYLES_DIR=$$PWD/../../styles"
+
+
+LIBS += -L$${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core widgets
+include(../../acss.pri)
+INCLUDEPATH += ../../src/core ../../src/widgets
+DEPENDPATH += ../../src/core ../../src/widgets
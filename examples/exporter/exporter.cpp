@@ -1,6 +1,12 @@
-#include <StyleManager.h>
+#include <StyleProcessor.h>
+#include <StylesheetAnalyzer.h>
+#include <StyleTemplate.h>
 #include <QCoreApplication>
+#include <QCommandLineParser>
 #include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 #include <iostream>
 
@@ -9,14 +15,145 @@ using namespace acss;
 #define _STR(x) #x
 #define STRINGIFY(x)  _STR(x)
 
+/**
+ * Reads the JSON report from the given file
+ */
+static QJsonObject readReport(const QString& FileName)
+{
+	QFile ReportFile(FileName);
+	if (!ReportFile.open(QIODevice::ReadOnly))
+	{
+		return QJsonObject();
+	}
+	return QJsonDocument::fromJson(ReportFile.readAll()).object();
+}
+
+
+/**
+ * Analyzes the stylesheet template and the generated stylesheet, stores the
+ * report in the style output folder and compares it with the given baseline.
+ * Returns the number of regressions.
+ */
+static int analyzeStylesheet(const CStyleProcessor& StyleManager,
+	const QString& Stylesheet, const QString& BaselineFile, double Threshold)
+{
+	CStylesheetAnalyzer Analyzer;
+	auto Report = Analyzer.analyze(Stylesheet);
+	std::cout << CStylesheetAnalyzer::textReport(Report).toStdString() << std::endl;
+
+	auto ReportFileName = StyleManager.currentStyleOutputPath() + "/"
+		+ StyleManager.currentStyle() + ".analysis.json";
+	QFile ReportFile(ReportFileName);
+	if (ReportFile.open(QIODevice::WriteOnly))
+	{
+		ReportFile.write(QJsonDocument(Report).toJson());
+		std::cout << "Analysis report written to "
+			<< ReportFileName.toStdString() << std::endl;
+	}
+
+	if (BaselineFile.isEmpty())
+	{
+		return 0;
+	}
+
+	auto Baseline = readReport(BaselineFile);
+	if (Baseline.isEmpty())
+	{
+		std::cerr << "Error reading baseline " << BaselineFile.toStdString() << std::endl;
+		return 1;
+	}
+
+	auto Regressions = CStylesheetAnalyzer::compare(Baseline, Report, Threshold);
+	for (const auto& Regression : Regressions)
+	{
+		std::cerr << "Regression: " << Regression.toStdString() << std::endl;
+	}
+	return Regressions.size();
+}
+
+
+/**
+ * Compiles the stylesheet template of the current style and writes a C++
+ * renderer source for it into the given file.
+ * Returns false on error.
+ */
+static bool exportCppRenderer(const CStyleProcessor& StyleManager,
+	const QString& FileName, const QString& FunctionName)
+{
+	auto TemplateFileName = StyleManager.styleParameters().value("css_template").toString();
+	QFile TemplateFile(StyleManager.currentStylePath() + "/" + TemplateFileName);
+	if (TemplateFileName.isEmpty() || !TemplateFile.open(QIODevice::ReadOnly))
+	{
+		std::cerr << "The style has no stylesheet template" << std::endl;
+		return false;
+	}
+
+	CStyleTemplate Template;
+	Template.compile(TemplateFile.readAll());
+	QFile SourceFile(FileName);
+	if (!SourceFile.open(QIODevice::WriteOnly))
+	{
+		std::cerr << "Error writing " << FileName.toStdString() << std::endl;
+		return false;
+	}
+
+	SourceFile.write(Template.toCppSource(FunctionName, TemplateFileName).toUtf8());
+	std::cout << "Renderer " << FunctionName.toStdString() << "() with "
+		<< Template.variableIds().size() << " variables written to "
+		<< FileName.toStdString() << std::endl;
+	return true;
+}
+
+
 int main(int argc, char *argv[])
 {
     QCoreApplication a(argc, argv);
-    CStyleManager StyleManager;
     QString AppDir = qApp->applicationDirPath();
+
+    QCommandLineParser Parser;
+    Parser.setApplicationDescription("Generates the stylesheet and the "
+    	"resources of a style theme");
+    Parser.addHelpOption();
+    QCommandLineOption StyleOption("style", "The style to process", "style", "qt_material");
+    QCommandLineOption ThemeOption("theme", "The theme to process", "theme", "dark_teal");
+    QCommandLineOption OutputOption("output", "The output directory", "dir", AppDir + "/output");
+    QCommandLineOption AnalyzeOption("analyze", "Analyze the complexity of "
+    	"the generated stylesheet");
+    QCommandLineOption BaselineOption("baseline", "Compare the analysis report "
+    	"with the given baseline report and fail on regressions", "file");
+    QCommandLineOption ThresholdOption("threshold", "Allowed increase of the "
+    	"analysis values in percent", "percent", "0");
+    QCommandLineOption CppOption("cpp", "Write a C++ renderer source for the "
+    	"stylesheet template into the given file", "file");
+    QCommandLineOption CppFunctionOption("cpp-function", "Name of the generated "
+    	"C++ render function", "name", "renderStylesheet");
+    Parser.addOptions({StyleOption, ThemeOption, OutputOption, AnalyzeOption,
+    	BaselineOption, ThresholdOption, CppOption, CppFunctionOption});
+    Parser.process(a);
+
+    CStyleProcessor StyleManager;
     QString StylesDir = STRINGIFY(STYLES_DIR);
     StyleManager.setStylesDirPath(StylesDir);
-    StyleManager.setOutputDirPath(AppDir + "/output");
-    StyleManager.setCurrentStyle("qt_material");
-    StyleManager.setCurrentTheme("dark_teal");
+    StyleManager.setOutputDirPath(Parser.value(OutputOption));
+    StyleManager.setCurrentStyle(Parser.value(StyleOption));
+    if (!StyleManager.setCurrentTheme(Parser.value(ThemeOption))
+     || !StyleManager.updateStylesheet())
+    {
+    	std::cerr << StyleManager.errorString().toStdString() << std::endl;
+    	return 1;
+    }
+
+    if (Parser.isSet(CppOption) && !exportCppRenderer(StyleManager,
+    	Parser.value(CppOption), Parser.value(CppFunctionOption)))
+    {
+    	return 1;
+    }
+
+    if (Parser.isSet(AnalyzeOption) || Parser.isSet(BaselineOption))
+    {
+    	return analyzeStylesheet(StyleManager, StyleManager.styleSheet(),
+    		Parser.value(BaselineOption),
+    		Parser.value(ThresholdOption).toDouble()) ? 1 : 0;
+    }
+    return 0;
 }
@@ -1,6 +1,6 @@
 ACSS_OUT_ROOT = $${OUT_PWD}/../..
 
-QT += core gui widgets
+QT = core
 
 
 TARGET = exporter
@@ -23,6 +23,7 @@ DEFINES += "STYLES_DIR=$$PWD/../../styles"
 
 
 LIBS += -L$${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core
 include(../../acss.pri)
-INCLUDEPATH += ../../src
-DEPENDPATH += ../../src    
+INCLUDEPATH += ../../src/core
+DEPENDPATH += ../../src/core    
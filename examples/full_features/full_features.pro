@@ -13,10 +13,12 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 SOURCES += \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    stresstest.cpp
 
 HEADERS += \
-    mainwindow.h
+    mainwindow.h \
+    stresstest.h
 
 FORMS += \
     mainwindow.ui
@@ -27,9 +29,10 @@ DEFINES += "STYLES_DIR=$$PWD/../../styles"
 
 
 LIBS += -L$${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core widgets qml
 include(../../acss.pri)
-INCLUDEPATH += ../../src
-DEPENDPATH += ../../src
+INCLUDEPATH += ../../src/core ../../src/widgets ../../src/qml
+DEPENDPATH += ../../src/core ../../src/widgets ../../src/qml
 
 DISTFILES += \
     qml/simple_demo.qml
@@ -1,11 +1,33 @@
 #include <QApplication>
+#include <QCommandLineParser>
 
 #include "mainwindow.h"
+#include "stresstest.h"
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    QCommandLineParser Parser;
+    Parser.setApplicationDescription("Shows all widgets with the selected "
+        "theme. Use -platform offscreen to run the stress test headless.");
+    Parser.addHelpOption();
+    QCommandLineOption StressOption("stress", "Cycle through all themes and "
+        "theme variable edits and record the switch latencies");
+    QCommandLineOption CyclesOption("cycles", "Number of stress test cycles",
+        "count", "3");
+    QCommandLineOption ReportOption("report", "The stress test report file",
+        "file", a.applicationDirPath() + "/stress_report.json");
+    Parser.addOptions({StressOption, CyclesOption, ReportOption});
+    Parser.process(a);
+
     CMainWindow w;
     w.show();
+    if (Parser.isSet(StressOption))
+    {
+        auto StressTest = new CStressTest(w.styleManager(), &w, &w);
+        StressTest->setCycles(Parser.value(CyclesOption).toInt());
+        StressTest->setReportFile(Parser.value(ReportOption));
+        StressTest->start();
+    }
     return a.exec();
 }
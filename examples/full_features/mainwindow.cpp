@@ -141,11 +141,11 @@ CMainWindow::CMainWindow(QWidget *parent)
     d->StyleManager = new acss::CStyleManager(this);
     d->StyleManager->setStylesDirPath(StylesDir);
     d->StyleManager->setOutputDirPath(AppDir + "/output");
+    d->StyleManager->setVariableOverridesFilePath(AppDir + "/overrides.json");
     d->StyleManager->setCurrentStyle("qt_material");
     d->StyleManager->setCurrentTheme("dark_teal");
-    d->StyleManager->updateStylesheet();
+    d->StyleManager->updateApplicationStyle();
     setWindowIcon(d->StyleManager->styleIcon());
-    qApp->setStyleSheet(d->StyleManager->styleSheet());
     connect(d->StyleManager, SIGNAL(stylesheetChanged()), this,
     	SLOT(onStyleManagerStylesheetChanged()));
 
@@ -161,17 +161,22 @@ CMainWindow::~CMainWindow()
 }
 
 
+acss::CStyleManager* CMainWindow::styleManager() const
+{
+	return d->StyleManager;
+}
+
+
 void CMainWindow::onThemeActionTriggered()
 {
 	auto Action = qobject_cast<QAction*>(sender());
 	d->StyleManager->setCurrentTheme(Action->text());
-	d->StyleManager->updateStylesheet();
+	d->StyleManager->requestApplicationStyleUpdate();
 }
 
 
 void CMainWindow::onStyleManagerStylesheetChanged()
 {
-	qApp->setStyleSheet(d->StyleManager->styleSheet());
 	d->updateThemeColorButtons();
 	d->updateQuickWidget();
 }
@@ -188,7 +193,7 @@ void CMainWindow::onThemeColorButtonClicked()
 		return;
 	}
 	Color = ColorDialog.currentColor();
-	d->StyleManager->setThemeVariableValue(Button->text(), Color.name());
-	d->StyleManager->updateStylesheet();
+	d->StyleManager->setVariableOverride(Button->text(), Color.name());
+	d->StyleManager->updateApplicationStyle();
 }
 
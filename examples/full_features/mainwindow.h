@@ -9,6 +9,11 @@ QT_END_NAMESPACE
 
 struct MainWindowPrivate;
 
+namespace acss
+{
+class CStyleManager;
+}
+
 class CMainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -17,6 +22,11 @@ public:
     CMainWindow(QWidget *parent = nullptr);
     virtual ~CMainWindow();
 
+    /**
+     * Returns the style manager of the main window
+     */
+    acss::CStyleManager* styleManager() const;
+
 private:
     MainWindowPrivate* d;
     friend struct MainWindowPrivate;// pimpl
@@ -0,0 +1,161 @@
+#include "stresstest.h"
+
+#include <StyleManager.h>
+
+#include <QApplication>
+#include <QColor>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTimer>
+#include <QWidget>
+
+#include <algorithm>
+#include <iostream>
+
+
+/**
+ * Returns count, mean, median, 95th percentile and maximum of the given
+ * values of all steps
+ */
+static QJsonObject statistics(const QJsonArray& Steps, const QString& Key)
+{
+    QVector<double> Values;
+    for (const auto& Step : Steps)
+    {
+        Values.append(Step.toObject().value(Key).toDouble());
+    }
+    std::sort(Values.begin(), Values.end());
+
+    QJsonObject jStatistics;
+    if (Values.isEmpty())
+    {
+        return jStatistics;
+    }
+
+    double Sum = 0;
+    for (auto Value : Values)
+    {
+        Sum += Value;
+    }
+    jStatistics.insert("count", Values.size());
+    jStatistics.insert("mean_ms", Sum / Values.size());
+    jStatistics.insert("median_ms", Values.at(Values.size() / 2));
+    jStatistics.insert("p95_ms", Values.at(std::min(Values.size() - 1,
+        int(Values.size() * 0.95))));
+    jStatistics.insert("max_ms", Values.last());
+    return jStatistics;
+}
+
+
+CStressTest::CStressTest(acss::CStyleManager* StyleManager, QWidget* Window,
+    QObject* parent)
+    : QObject(parent),
+      StyleManager(StyleManager),
+      Window(Window)
+{
+
+}
+
+
+void CStressTest::setCycles(int Cycles)
+{
+    this->Cycles = std::max(1, Cycles);
+}
+
+
+void CStressTest::setReportFile(const QString& FileName)
+{
+    ReportFile = FileName;
+}
+
+
+void CStressTest::start()
+{
+    Step = 0;
+    Steps = QJsonArray();
+    QTimer::singleShot(0, this, SLOT(runNextStep()));
+}
+
+
+void CStressTest::runNextStep()
+{
+    const auto& Themes = StyleManager->themes();
+    // Each theme switch is followed by a variable edit
+    int StepCount = Themes.size() * Cycles * 2;
+    if (Step >= StepCount || Themes.isEmpty())
+    {
+        writeReport();
+        qApp->quit();
+        return;
+    }
+
+    CurrentStep = QJsonObject();
+    // The zero timer fires as soon as the event loop processes events again,
+    // so its delay is the duration the event loop has been blocked
+    StepTimer.start();
+    QTimer::singleShot(0, this, SLOT(onEventLoopResumed()));
+
+    if (Step % 2 == 0)
+    {
+        auto Theme = Themes.at((Step / 2) % Themes.size());
+        CurrentStep.insert("operation", QString("theme"));
+        CurrentStep.insert("theme", Theme);
+        StyleManager->setCurrentTheme(Theme);
+    }
+    else
+    {
+        // Rotate the hue of the primary color to force a real change
+        auto Color = StyleManager->themeColor("primaryColor");
+        Color = QColor::fromHsv((Color.hsvHue() + 40) % 360,
+            Color.hsvSaturation(), Color.value());
+        CurrentStep.insert("operation", QString("variable"));
+        CurrentStep.insert("theme", StyleManager->currentTheme());
+        StyleManager->setThemeVariableValue("primaryColor", Color.name());
+    }
+    StyleManager->updateApplicationStyle();
+    CurrentStep.insert("latency_ms", StepTimer.nsecsElapsed() / 1000000.0);
+
+    QElapsedTimer FrameTimer;
+    FrameTimer.start();
+    Window->repaint();
+    CurrentStep.insert("frame_ms", FrameTimer.nsecsElapsed() / 1000000.0);
+    Step++;
+}
+
+
+void CStressTest::onEventLoopResumed()
+{
+    CurrentStep.insert("stall_ms", StepTimer.nsecsElapsed() / 1000000.0);
+    Steps.append(CurrentStep);
+    std::cout << CurrentStep.value("operation").toString().toStdString() << " "
+        << CurrentStep.value("theme").toString().toStdString() << ": latency "
+        << CurrentStep.value("latency_ms").toDouble() << " ms, stall "
+        << CurrentStep.value("stall_ms").toDouble() << " ms, frame "
+        << CurrentStep.value("frame_ms").toDouble() << " ms" << std::endl;
+    QTimer::singleShot(0, this, SLOT(runNextStep()));
+}
+
+
+void CStressTest::writeReport()
+{
+    QJsonObject jSummary;
+    jSummary.insert("latency", statistics(Steps, "latency_ms"));
+    jSummary.insert("stall", statistics(Steps, "stall_ms"));
+    jSummary.insert("frame", statistics(Steps, "frame_ms"));
+
+    QJsonObject jReport;
+    jReport.insert("platform", QApplication::platformName());
+    jReport.insert("style", StyleManager->currentStyle());
+    jReport.insert("cycles", Cycles);
+    jReport.insert("summary", jSummary);
+    jReport.insert("steps", Steps);
+    jReport.insert("metrics", StyleManager->metrics());
+
+    std::cout << QJsonDocument(jSummary).toJson().constData();
+    QFile File(ReportFile);
+    if (!ReportFile.isEmpty() && File.open(QIODevice::WriteOnly))
+    {
+        File.write(QJsonDocument(jReport).toJson());
+        std::cout << "Stress test report written to " << ReportFile.toStdString() << std::endl;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef CSTRESSTEST_H
+#define CSTRESSTEST_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+
+class QWidget;
+
+namespace acss
+{
+class CStyleManager;
+}
+
+/**
+ * Automatic theme switch stress test.
+ * The test cycles through all themes of the style manager and changes
+ * theme variables in between. For each switch, it records the latency of
+ * the switch, the duration the event loop has been blocked and the time
+ * to repaint the window. When all switches are done, a summary is written
+ * to the report file and the application quits.
+ */
+class CStressTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CStressTest(acss::CStyleManager* StyleManager, QWidget* Window,
+        QObject* parent = nullptr);
+
+    /**
+     * Number of times all themes are cycled
+     */
+    void setCycles(int Cycles);
+
+    /**
+     * The file the JSON summary is written to
+     */
+    void setReportFile(const QString& FileName);
+
+public slots:
+    void start();
+
+private slots:
+    void runNextStep();
+    void onEventLoopResumed();
+
+private:
+    acss::CStyleManager* StyleManager;
+    QWidget* Window;
+    int Cycles = 3;
+    int Step = 0;
+    QString ReportFile;
+    QElapsedTimer StepTimer;
+    QJsonObject CurrentStep;
+    QJsonArray Steps;
+
+    void writeReport();
+};
+
+#endif // CSTRESSTEST_H
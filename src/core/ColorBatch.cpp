@@ -0,0 +1,551 @@
+//============================================================================
+/// \file   ColorBatch.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CColorBatch class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <ColorBatch.h>
+#include <StyleSimd.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace acss
+{
+/**
+ * Multiplies the vectors (X[i], Y[i], Z[i]) with the 3x3 row major matrix M
+ */
+static void transform3(float* X, float* Y, float* Z, const float M[9], int Size)
+{
+	int i = 0;
+#ifdef ACSS_SSE2
+	for (; i + 4 <= Size; i += 4)
+	{
+		auto x = _mm_loadu_ps(X + i);
+		auto y = _mm_loadu_ps(Y + i);
+		auto z = _mm_loadu_ps(Z + i);
+		auto Row = [&](int r)
+		{
+			return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(M[r * 3])),
+				_mm_mul_ps(y, _mm_set1_ps(M[r * 3 + 1]))),
+				_mm_mul_ps(z, _mm_set1_ps(M[r * 3 + 2])));
+		};
+		_mm_storeu_ps(X + i, Row(0));
+		_mm_storeu_ps(Y + i, Row(1));
+		_mm_storeu_ps(Z + i, Row(2));
+	}
+#endif
+	for (; i < Size; ++i)
+	{
+		float x = X[i], y = Y[i], z = Z[i];
+		X[i] = M[0] * x + M[1] * y + M[2] * z;
+		Y[i] = M[3] * x + M[4] * y + M[5] * z;
+		Z[i] = M[6] * x + M[7] * y + M[8] * z;
+	}
+}
+
+
+/**
+ * Out[i] = A[i] + (B[i] - A[i]) * Position
+ */
+static void lerp(float* Out, const float* A, const float* B, float Position, int Size)
+{
+	int i = 0;
+#ifdef ACSS_SSE2
+	auto t = _mm_set1_ps(Position);
+	for (; i + 4 <= Size; i += 4)
+	{
+		auto a = _mm_loadu_ps(A + i);
+		auto b = _mm_loadu_ps(B + i);
+		_mm_storeu_ps(Out + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
+	}
+#endif
+	for (; i < Size; ++i)
+	{
+		Out[i] = A[i] + (B[i] - A[i]) * Position;
+	}
+}
+
+
+/**
+ * Multiplies all values of Data with the value of Factors with the same index
+ */
+static void multiply(float* Data, const float* Factors, int Size)
+{
+	int i = 0;
+#ifdef ACSS_SSE2
+	for (; i + 4 <= Size; i += 4)
+	{
+		_mm_storeu_ps(Data + i, _mm_mul_ps(_mm_loadu_ps(Data + i),
+			_mm_loadu_ps(Factors + i)));
+	}
+#endif
+	for (; i < Size; ++i)
+	{
+		Data[i] *= Factors[i];
+	}
+}
+
+
+/**
+ * Multiplies all values with the given factor
+ */
+static void scale(float* Data, float Factor, int Size)
+{
+	int i = 0;
+#ifdef ACSS_SSE2
+	auto f = _mm_set1_ps(Factor);
+	for (; i + 4 <= Size; i += 4)
+	{
+		_mm_storeu_ps(Data + i, _mm_mul_ps(_mm_loadu_ps(Data + i), f));
+	}
+#endif
+	for (; i < Size; ++i)
+	{
+		Data[i] *= Factor;
+	}
+}
+
+
+/**
+ * Returns the value of the given hex digit or -1
+ */
+static int hexValue(QChar Char)
+{
+	auto c = Char.unicode();
+	if (c >= '0' && c <= '9') return c - '0';
+	if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+
+//============================================================================
+CColorBatch::CColorBatch(const QStringList& Colors)
+{
+	resize(Colors.size());
+	for (int i = 0; i < Colors.size(); ++i)
+	{
+		float Rgba[4] = {0, 0, 0, 0};
+		parseColor(Colors[i], Rgba);
+		for (int c = 0; c < 4; ++c)
+		{
+			Channels[c][i] = Rgba[c];
+		}
+	}
+}
+
+
+//============================================================================
+bool CColorBatch::parseColor(const QString& Color, float Rgba[4])
+{
+	if (!Color.startsWith('#'))
+	{
+		return false;
+	}
+
+	int Digits = Color.size() - 1;
+	if (Digits != 3 && Digits != 6 && Digits != 8)
+	{
+		return false;
+	}
+
+	int Values[8];
+	for (int i = 0; i < Digits; ++i)
+	{
+		Values[i] = hexValue(Color[i + 1]);
+		if (Values[i] < 0)
+		{
+			return false;
+		}
+	}
+
+	if (Digits == 3)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			Rgba[c] = Values[c] * 17 / 255.0f;
+		}
+		Rgba[3] = 1;
+		return true;
+	}
+
+	// The alpha value comes first in the "#aarrggbb" format
+	int Offset = (Digits == 8) ? 2 : 0;
+	for (int c = 0; c < 3; ++c)
+	{
+		Rgba[c] = (Values[Offset + c * 2] * 16 + Values[Offset + c * 2 + 1]) / 255.0f;
+	}
+	Rgba[3] = (Digits == 8) ? (Values[0] * 16 + Values[1]) / 255.0f : 1.0f;
+	return true;
+}
+
+
+//============================================================================
+bool CColorBatch::append(const QString& Color)
+{
+	convertTo(Srgb);
+	float Rgba[4] = {0, 0, 0, 0};
+	bool Result = parseColor(Color, Rgba);
+	for (int c = 0; c < 4; ++c)
+	{
+		Channels[c].append(Rgba[c]);
+	}
+	return Result;
+}
+
+
+//============================================================================
+void CColorBatch::clear()
+{
+	for (auto& Channel : Channels)
+	{
+		Channel.clear();
+	}
+	Space = Srgb;
+}
+
+
+//============================================================================
+void CColorBatch::resize(int Size)
+{
+	for (auto& Channel : Channels)
+	{
+		Channel.resize(Size);
+	}
+}
+
+
+//============================================================================
+void CColorBatch::convertTo(eColorSpace ColorSpace)
+{
+	if (ColorSpace == Space)
+	{
+		return;
+	}
+
+	// All conversions run via Srgb
+	switch (Space)
+	{
+	case LinearSrgb: linearToSrgb(); break;
+	case OkLab: okLabToLinear(); linearToSrgb(); break;
+	case Hsl: hslToSrgb(); break;
+	case Srgb: break;
+	}
+
+	switch (ColorSpace)
+	{
+	case LinearSrgb: srgbToLinear(); break;
+	case OkLab: srgbToLinear(); linearToOkLab(); break;
+	case Hsl: srgbToHsl(); break;
+	case Srgb: break;
+	}
+	Space = ColorSpace;
+}
+
+
+//============================================================================
+void CColorBatch::srgbToLinear()
+{
+	for (int c = 0; c < 3; ++c)
+	{
+		for (auto& Value : Channels[c])
+		{
+			Value = (Value <= 0.04045f) ? Value / 12.92f
+				: std::pow((Value + 0.055f) / 1.055f, 2.4f);
+		}
+	}
+}
+
+
+//============================================================================
+void CColorBatch::linearToSrgb()
+{
+	for (int c = 0; c < 3; ++c)
+	{
+		for (auto& Value : Channels[c])
+		{
+			Value = (Value <= 0.0031308f) ? Value * 12.92f
+				: 1.055f * std::pow(Value, 1.0f / 2.4f) - 0.055f;
+		}
+	}
+}
+
+
+//============================================================================
+void CColorBatch::linearToOkLab()
+{
+	static const float ToLms[9] = {
+		0.4122214708f, 0.5363325363f, 0.0514459929f,
+		0.2119034982f, 0.6806995451f, 0.1073969566f,
+		0.0883024619f, 0.2817188376f, 0.6299787005f};
+	static const float ToLab[9] = {
+		0.2104542553f, 0.7936177850f, -0.0040720468f,
+		1.9779984951f, -2.4285922050f, 0.4505937099f,
+		0.0259040371f, 0.7827717662f, -0.8086757660f};
+
+	int Size = size();
+	transform3(Channels[0].data(), Channels[1].data(), Channels[2].data(), ToLms, Size);
+	for (int c = 0; c < 3; ++c)
+	{
+		for (auto& Value : Channels[c])
+		{
+			Value = std::cbrt(Value);
+		}
+	}
+	transform3(Channels[0].data(), Channels[1].data(), Channels[2].data(), ToLab, Size);
+}
+
+
+//============================================================================
+void CColorBatch::okLabToLinear()
+{
+	static const float ToLms[9] = {
+		1.0f, 0.3963377774f, 0.2158037573f,
+		1.0f, -0.1055613458f, -0.0638541728f,
+		1.0f, -0.0894841775f, -1.2914855480f};
+	static const float ToRgb[9] = {
+		4.0767416621f, -3.3077115913f, 0.2309699292f,
+		-1.2684380046f, 2.6097574011f, -0.3413193965f,
+		-0.0041960863f, -0.7034186147f, 1.7076147010f};
+
+	int Size = size();
+	transform3(Channels[0].data(), Channels[1].data(), Channels[2].data(), ToLms, Size);
+	for (int c = 0; c < 3; ++c)
+	{
+		for (auto& Value : Channels[c])
+		{
+			Value = Value * Value * Value;
+		}
+	}
+	transform3(Channels[0].data(), Channels[1].data(), Channels[2].data(), ToRgb, Size);
+}
+
+
+//============================================================================
+void CColorBatch::srgbToHsl()
+{
+	auto R = Channels[0].data();
+	auto G = Channels[1].data();
+	auto B = Channels[2].data();
+	for (int i = 0; i < size(); ++i)
+	{
+		float Max = std::max({R[i], G[i], B[i]});
+		float Min = std::min({R[i], G[i], B[i]});
+		float Lightness = (Max + Min) / 2;
+		float Hue = 0;
+		float Saturation = 0;
+		float Delta = Max - Min;
+		if (Delta > 0)
+		{
+			Saturation = (Lightness > 0.5f) ? Delta / (2 - Max - Min) : Delta / (Max + Min);
+			if (Max == R[i])
+			{
+				Hue = (G[i] - B[i]) / Delta + (G[i] < B[i] ? 6 : 0);
+			}
+			else if (Max == G[i])
+			{
+				Hue = (B[i] - R[i]) / Delta + 2;
+			}
+			else
+			{
+				Hue = (R[i] - G[i]) / Delta + 4;
+			}
+			Hue /= 6;
+		}
+		R[i] = Hue;
+		G[i] = Saturation;
+		B[i] = Lightness;
+	}
+}
+
+
+//============================================================================
+void CColorBatch::hslToSrgb()
+{
+	auto HueToRgb = [](float p, float q, float t)
+	{
+		if (t < 0) t += 1;
+		if (t > 1) t -= 1;
+		if (t < 1.0f / 6) return p + (q - p) * 6 * t;
+		if (t < 1.0f / 2) return q;
+		if (t < 2.0f / 3) return p + (q - p) * (2.0f / 3 - t) * 6;
+		return p;
+	};
+
+	auto H = Channels[0].data();
+	auto S = Channels[1].data();
+	auto L = Channels[2].data();
+	for (int i = 0; i < size(); ++i)
+	{
+		float Hue = H[i], Saturation = S[i], Lightness = L[i];
+		if (Saturation <= 0)
+		{
+			H[i] = S[i] = L[i] = Lightness;
+			continue;
+		}
+
+		float q = (Lightness < 0.5f) ? Lightness * (1 + Saturation)
+			: Lightness + Saturation - Lightness * Saturation;
+		float p = 2 * Lightness - q;
+		H[i] = HueToRgb(p, q, Hue + 1.0f / 3);
+		S[i] = HueToRgb(p, q, Hue);
+		L[i] = HueToRgb(p, q, Hue - 1.0f / 3);
+	}
+}
+
+
+//============================================================================
+void CColorBatch::multiplyAlpha(float Factor)
+{
+	scale(Channels[3].data(), Factor, size());
+}
+
+
+//============================================================================
+void CColorBatch::multiplyAlpha(const QVector<float>& Factors)
+{
+	multiply(Channels[3].data(), Factors.constData(), std::min(size(), Factors.size()));
+}
+
+
+//============================================================================
+void CColorBatch::setAlpha(float Alpha)
+{
+	std::fill(Channels[3].begin(), Channels[3].end(), Alpha);
+}
+
+
+//============================================================================
+void CColorBatch::adjustLightness(float Delta)
+{
+	convertTo(Hsl);
+	for (auto& Lightness : Channels[2])
+	{
+		Lightness = std::min(1.0f, std::max(0.0f, Lightness + Delta));
+	}
+}
+
+
+//============================================================================
+void CColorBatch::interpolate(const CColorBatch& From, const CColorBatch& To,
+	float Position)
+{
+	int Size = std::min(From.size(), To.size());
+	resize(Size);
+	Space = From.Space;
+	for (int c = 0; c < 4; ++c)
+	{
+		lerp(Channels[c].data(), From.Channels[c].constData(),
+			To.Channels[c].constData(), Position, Size);
+	}
+
+	if (Space != Hsl)
+	{
+		return;
+	}
+
+	// The hue is an angle - a transition from 0.9 to 0.1 passes 0 and not
+	// all the other hues in between
+	auto Hue = Channels[0].data();
+	auto FromHue = From.Channels[0].constData();
+	auto ToHue = To.Channels[0].constData();
+	for (int i = 0; i < Size; ++i)
+	{
+		float Delta = ToHue[i] - FromHue[i];
+		if (Delta > 0.5f)
+		{
+			Delta -= 1;
+		}
+		else if (Delta < -0.5f)
+		{
+			Delta += 1;
+		}
+		Hue[i] = FromHue[i] + Delta * Position;
+		Hue[i] -= std::floor(Hue[i]);
+	}
+}
+
+
+//============================================================================
+QString CColorBatch::name(int Index, bool TruncateAlpha) const
+{
+	Q_ASSERT(Space == Srgb);
+	auto toByte = [](float Value)
+	{
+		return qRound(std::min(1.0f, std::max(0.0f, Value)) * 255);
+	};
+
+	int Alpha = TruncateAlpha
+		? int(std::min(1.0f, std::max(0.0f, Channels[3][Index])) * 255)
+		: toByte(Channels[3][Index]);
+	QString Name("#");
+	if (Alpha < 255)
+	{
+		Name += QString("%1").arg(Alpha, 2, 16, QChar('0'));
+	}
+	for (int c = 0; c < 3; ++c)
+	{
+		Name += QString("%1").arg(toByte(Channels[c][Index]), 2, 16, QChar('0'));
+	}
+	return Name;
+}
+
+
+//============================================================================
+QStringList CColorBatch::names() const
+{
+	Q_ASSERT(Space == Srgb);
+	QStringList Names;
+	Names.reserve(size());
+	for (int i = 0; i < size(); ++i)
+	{
+		Names.append(name(i));
+	}
+	return Names;
+}
+
+
+//============================================================================
+QMap<QString, QString> CColorBatch::interpolateColors(
+	const QMap<QString, QString>& From, const QMap<QString, QString>& To,
+	float Position)
+{
+	QStringList Keys;
+	QStringList FromColors;
+	QStringList ToColors;
+	for (auto itc = From.constBegin(); itc != From.constEnd(); ++itc)
+	{
+		auto ToColor = To.value(itc.key());
+		if (!ToColor.isEmpty())
+		{
+			Keys.append(itc.key());
+			FromColors.append(itc.value());
+			ToColors.append(ToColor);
+		}
+	}
+
+	CColorBatch FromBatch(FromColors);
+	CColorBatch ToBatch(ToColors);
+	FromBatch.convertTo(OkLab);
+	ToBatch.convertTo(OkLab);
+	CColorBatch Frame;
+	Frame.interpolate(FromBatch, ToBatch, Position);
+	Frame.convertTo(Srgb);
+
+	QMap<QString, QString> Colors;
+	for (int i = 0; i < Keys.size(); ++i)
+	{
+		Colors.insert(Keys[i], Frame.name(i));
+	}
+	return Colors;
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF ColorBatch.cpp
@@ -0,0 +1,171 @@
+#ifndef ColorBatchH
+#define ColorBatchH
+//============================================================================
+/// \file   ColorBatch.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CColorBatch class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+
+namespace acss
+{
+/**
+ * Batch of colors for the derivation of palettes, opacity variants, shades
+ * and transition frames.
+ * The colors are stored as floats in a struct of arrays layout - one array
+ * per channel - so that each operation runs over all colors of the batch at
+ * once. The linear parts of the operations (blending, alpha, the matrix
+ * steps of the OKLab conversion) use SSE2 if it is available.
+ * This class only depends on QtCore, so it does not use QColor. Colors are
+ * read from and written to color names in the "#rgb", "#rrggbb" and
+ * "#aarrggbb" formats that are used in the theme files.
+ * \code
+ * CColorBatch From(LightColors.values()), To(DarkColors.values());
+ * From.convertTo(CColorBatch::OkLab);
+ * To.convertTo(CColorBatch::OkLab);
+ * CColorBatch Frame;
+ * Frame.interpolate(From, To, 0.5);
+ * Frame.convertTo(CColorBatch::Srgb);
+ * auto Colors = Frame.names();
+ * \endcode
+ */
+class CColorBatch
+{
+public:
+	enum eColorSpace
+	{
+		Srgb, ///< channels: red, green, blue, alpha
+		LinearSrgb, ///< channels: linear red, green, blue, alpha
+		Hsl, ///< channels: hue (0 - 1), saturation, lightness, alpha
+		OkLab ///< channels: L, a, b, alpha
+	};
+
+	/**
+	 * Creates an empty batch
+	 */
+	CColorBatch() = default;
+
+	/**
+	 * Creates a batch from the given color names. Invalid names are stored
+	 * as transparent black.
+	 */
+	explicit CColorBatch(const QStringList& Colors);
+
+	/**
+	 * Appends the color with the given name. The batch is converted to
+	 * Srgb before.
+	 * Returns false, if the name is not a valid color.
+	 */
+	bool append(const QString& Color);
+
+	/**
+	 * Returns the number of colors
+	 */
+	int size() const {return Channels[0].size();}
+
+	/**
+	 * Removes all colors
+	 */
+	void clear();
+
+	/**
+	 * Returns the color space of the channels
+	 */
+	eColorSpace colorSpace() const {return Space;}
+
+	/**
+	 * Returns the array with the values of the given channel (0 - 3)
+	 */
+	const float* channel(int Channel) const {return Channels[Channel].constData();}
+
+	/**
+	 * Converts all colors into the given color space
+	 */
+	void convertTo(eColorSpace ColorSpace);
+
+	/**
+	 * Multiplies the alpha channel of all colors with the given factor
+	 */
+	void multiplyAlpha(float Factor);
+
+	/**
+	 * Multiplies the alpha channel of each color with the factor of the same
+	 * index. Factors needs to contain size() values.
+	 */
+	void multiplyAlpha(const QVector<float>& Factors);
+
+	/**
+	 * Sets the alpha channel of all colors to the given value
+	 */
+	void setAlpha(float Alpha);
+
+	/**
+	 * Adds the given value to the HSL lightness of all colors. Positive
+	 * values lighten, negative values darken the colors. The batch is
+	 * converted to Hsl.
+	 */
+	void adjustLightness(float Delta);
+
+	/**
+	 * Sets this batch to the linear interpolation between From (Position 0)
+	 * and To (Position 1). Both batches need to have the same size and
+	 * color space. Interpolate in OkLab for perceptually even transitions.
+	 * In Hsl, the hue takes the shortest way around the color circle.
+	 * The function reuses the memory of this batch, so it can be called
+	 * for each frame of a transition without allocations.
+	 */
+	void interpolate(const CColorBatch& From, const CColorBatch& To, float Position);
+
+	/**
+	 * Returns the name of the color with the given index. The batch needs to
+	 * be in Srgb. Colors with alpha are returned as "#aarrggbb".
+	 * The channels are rounded to the nearest byte value. If TruncateAlpha
+	 * is true, the alpha value is truncated instead - this is the rounding
+	 * of the opacity filter of the stylesheet templates.
+	 */
+	QString name(int Index, bool TruncateAlpha = false) const;
+
+	/**
+	 * Returns the names of all colors. The batch needs to be in Srgb.
+	 */
+	QStringList names() const;
+
+	/**
+	 * Parses the given color name into red, green, blue and alpha values in
+	 * the range from 0 to 1.
+	 * Returns false, if the name is not a valid color.
+	 */
+	static bool parseColor(const QString& Color, float Rgba[4]);
+
+	/**
+	 * Returns the colors of a transition frame between the theme colors
+	 * From (Position 0) and To (Position 1). The colors are interpolated in
+	 * OkLab. Only variables that exist in both maps are returned.
+	 */
+	static QMap<QString, QString> interpolateColors(const QMap<QString, QString>& From,
+		const QMap<QString, QString>& To, float Position);
+
+private:
+	QVector<float> Channels[4];
+	eColorSpace Space = Srgb;
+
+	void resize(int Size);
+	void srgbToLinear();
+	void linearToSrgb();
+	void linearToOkLab();
+	void okLabToLinear();
+	void srgbToHsl();
+	void hslToSrgb();
+}; // class CColorBatch
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // ColorBatchH
@@ -0,0 +1,558 @@
+//============================================================================
+/// \file   StyleCache.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStyleCache class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleCache.h>
+
+#include <algorithm>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QVector>
+
+namespace acss
+{
+/**
+ * Cached artifact and the tick of its last access
+ */
+struct CacheEntry
+{
+	QByteArray Data;
+	quint64 Tick = 0;
+};
+
+
+/**
+ * Artifacts and statistics of one artifact kind
+ */
+struct ArtifactStore
+{
+	QHash<QString, CacheEntry> Entries;
+	QMap<quint64, QString> LruOrder; ///< access tick -> key
+	qint64 Size = 0;
+	qint64 Budget = -1;
+	qint64 Hits = 0;
+	qint64 SpillHits = 0;
+	qint64 Misses = 0;
+	qint64 Evictions = 0;
+	qint64 Spills = 0;
+};
+
+
+/**
+ * Evicted artifact that still needs to be written to the spill directory
+ */
+struct SpillItem
+{
+	CStyleCache::eArtifactKind Kind;
+	QString FilePath;
+	QByteArray Data;
+};
+
+
+/**
+ * Private data class of CStyleCache class (pimpl)
+ */
+struct StyleCachePrivate
+{
+	CStyleCache *_this;
+	mutable QMutex Mutex;
+	ArtifactStore Stores[CStyleCache::ArtifactKindCount];
+	qint64 Budget = 8 * 1024 * 1024;
+	qint64 Size = 0;
+	quint64 Tick = 0;
+	QString SpillDir;
+	QVector<SpillItem> PendingSpills;
+
+	/**
+	 * Private data constructor
+	 */
+	StyleCachePrivate(CStyleCache *_public);
+
+	/**
+	 * Deletes the spill files of all artifact kinds in the given directory
+	 */
+	static void removeSpillFiles(const QString& Dir);
+
+	/**
+	 * Returns the spill file path for the given artifact
+	 */
+	QString spillFilePath(CStyleCache::eArtifactKind Kind, const QString& Key) const;
+
+	/**
+	 * Stores the artifact in memory and marks it as most recently used
+	 */
+	void store(CStyleCache::eArtifactKind Kind, const QString& Key,
+		const QByteArray& Data);
+
+	/**
+	 * Evicts the least recently used entry of the given kind
+	 */
+	void evictOldest(CStyleCache::eArtifactKind Kind);
+
+	/**
+	 * Evicts entries until the kind budgets and the total budget are met
+	 */
+	void enforceBudgets(CStyleCache::eArtifactKind Kind);
+
+	/**
+	 * Queues the given artifact for the spill directory. The file is written
+	 * by writeSpills() after the mutex has been released, so the disk I/O
+	 * does not block the other pipeline stages.
+	 */
+	void spill(CStyleCache::eArtifactKind Kind, const QString& Key,
+		const QByteArray& Data);
+
+	/**
+	 * Takes the queued spill items. Call this with the mutex locked.
+	 */
+	QVector<SpillItem> takeSpills();
+
+	/**
+	 * Writes the given items to the spill directory. Call this without
+	 * holding the mutex.
+	 */
+	void writeSpills(const QVector<SpillItem>& Items);
+};// struct StyleCachePrivate
+
+
+//============================================================================
+StyleCachePrivate::StyleCachePrivate(
+    CStyleCache *_public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void StyleCachePrivate::removeSpillFiles(const QString& Dir)
+{
+	if (Dir.isEmpty())
+	{
+		return;
+	}
+
+	for (int i = 0; i < CStyleCache::ArtifactKindCount; ++i)
+	{
+		QDir(Dir + "/" + CStyleCache::kindName(
+			static_cast<CStyleCache::eArtifactKind>(i))).removeRecursively();
+	}
+}
+
+
+//============================================================================
+QString StyleCachePrivate::spillFilePath(CStyleCache::eArtifactKind Kind,
+	const QString& Key) const
+{
+	auto KeyHash = QCryptographicHash::hash(Key.toUtf8(), QCryptographicHash::Sha1);
+	return SpillDir + "/" + CStyleCache::kindName(Kind) + "/"
+		+ QString::fromLatin1(KeyHash.toHex());
+}
+
+
+//============================================================================
+void StyleCachePrivate::store(CStyleCache::eArtifactKind Kind,
+	const QString& Key, const QByteArray& Data)
+{
+	auto& Store = Stores[Kind];
+	auto it = Store.Entries.find(Key);
+	if (it != Store.Entries.end())
+	{
+		Store.LruOrder.remove(it->Tick);
+		Store.Size -= it->Data.size();
+		Size -= it->Data.size();
+	}
+	else
+	{
+		it = Store.Entries.insert(Key, CacheEntry());
+	}
+
+	it->Data = Data;
+	it->Tick = ++Tick;
+	Store.LruOrder.insert(it->Tick, Key);
+	Store.Size += Data.size();
+	Size += Data.size();
+}
+
+
+//============================================================================
+void StyleCachePrivate::evictOldest(CStyleCache::eArtifactKind Kind)
+{
+	auto& Store = Stores[Kind];
+	auto Oldest = Store.LruOrder.begin();
+	auto Key = Oldest.value();
+	Store.LruOrder.erase(Oldest);
+	auto Entry = Store.Entries.take(Key);
+	Store.Size -= Entry.Data.size();
+	Size -= Entry.Data.size();
+	Store.Evictions++;
+	spill(Kind, Key, Entry.Data);
+}
+
+
+//============================================================================
+void StyleCachePrivate::enforceBudgets(CStyleCache::eArtifactKind Kind)
+{
+	auto& Store = Stores[Kind];
+	while (Store.Budget >= 0 && Store.Size > Store.Budget)
+	{
+		evictOldest(Kind);
+	}
+
+	// Evict the globally least recently used entries - the entry with the
+	// smallest tick of all kinds
+	while (Size > Budget)
+	{
+		int OldestKind = -1;
+		quint64 OldestTick = 0;
+		for (int i = 0; i < CStyleCache::ArtifactKindCount; ++i)
+		{
+			if (Stores[i].LruOrder.isEmpty())
+			{
+				continue;
+			}
+
+			auto Tick = Stores[i].LruOrder.firstKey();
+			if (OldestKind < 0 || Tick < OldestTick)
+			{
+				OldestKind = i;
+				OldestTick = Tick;
+			}
+		}
+		evictOldest(static_cast<CStyleCache::eArtifactKind>(OldestKind));
+	}
+}
+
+
+//============================================================================
+void StyleCachePrivate::spill(CStyleCache::eArtifactKind Kind,
+	const QString& Key, const QByteArray& Data)
+{
+	if (SpillDir.isEmpty())
+	{
+		return;
+	}
+
+	PendingSpills.append({Kind, spillFilePath(Kind, Key), Data});
+}
+
+
+//============================================================================
+QVector<SpillItem> StyleCachePrivate::takeSpills()
+{
+	QVector<SpillItem> Items;
+	Items.swap(PendingSpills);
+	return Items;
+}
+
+
+//============================================================================
+void StyleCachePrivate::writeSpills(const QVector<SpillItem>& Items)
+{
+	for (const auto& Item : Items)
+	{
+		if (QFile::exists(Item.FilePath))
+		{
+			continue;
+		}
+
+		// QSaveFile renames the complete file into place, so a concurrent
+		// find() never reads a partially written spill file
+		QDir().mkpath(QFileInfo(Item.FilePath).absolutePath());
+		QSaveFile SpillFile(Item.FilePath);
+		if (!SpillFile.open(QIODevice::WriteOnly))
+		{
+			continue;
+		}
+		SpillFile.write(Item.Data);
+		if (SpillFile.commit())
+		{
+			QMutexLocker Lock(&Mutex);
+			Stores[Item.Kind].Spills++;
+		}
+	}
+}
+
+
+//============================================================================
+CStyleCache::CStyleCache() :
+	d(new StyleCachePrivate(this))
+{
+
+}
+
+
+//============================================================================
+CStyleCache::~CStyleCache()
+{
+	d->removeSpillFiles(d->SpillDir);
+	delete d;
+}
+
+
+//============================================================================
+void CStyleCache::setBudget(qint64 Bytes)
+{
+	QVector<SpillItem> Spills;
+	{
+		QMutexLocker Lock(&d->Mutex);
+		d->Budget = std::max<qint64>(Bytes, 0);
+		for (int i = 0; i < ArtifactKindCount; ++i)
+		{
+			d->enforceBudgets(static_cast<eArtifactKind>(i));
+		}
+		Spills = d->takeSpills();
+	}
+	d->writeSpills(Spills);
+}
+
+
+//============================================================================
+qint64 CStyleCache::budget() const
+{
+	QMutexLocker Lock(&d->Mutex);
+	return d->Budget;
+}
+
+
+//============================================================================
+void CStyleCache::setKindBudget(eArtifactKind Kind, qint64 Bytes)
+{
+	QVector<SpillItem> Spills;
+	{
+		QMutexLocker Lock(&d->Mutex);
+		d->Stores[Kind].Budget = Bytes;
+		d->enforceBudgets(Kind);
+		Spills = d->takeSpills();
+	}
+	d->writeSpills(Spills);
+}
+
+
+//============================================================================
+qint64 CStyleCache::kindBudget(eArtifactKind Kind) const
+{
+	QMutexLocker Lock(&d->Mutex);
+	return d->Stores[Kind].Budget;
+}
+
+
+//============================================================================
+void CStyleCache::setSpillDirPath(const QString& Path)
+{
+	QMutexLocker Lock(&d->Mutex);
+	if (Path == d->SpillDir)
+	{
+		return;
+	}
+
+	// Spill files of a previous run may belong to keys that are never
+	// requested again, so the new directory starts empty
+	d->removeSpillFiles(d->SpillDir);
+	d->removeSpillFiles(Path);
+	d->SpillDir = Path;
+}
+
+
+//============================================================================
+QString CStyleCache::spillDirPath() const
+{
+	QMutexLocker Lock(&d->Mutex);
+	return d->SpillDir;
+}
+
+
+//============================================================================
+bool CStyleCache::find(eArtifactKind Kind, const QString& Key, QByteArray& Data)
+{
+	QString SpillFilePath;
+	{
+		QMutexLocker Lock(&d->Mutex);
+		auto& Store = d->Stores[Kind];
+		auto it = Store.Entries.find(Key);
+		if (it != Store.Entries.end())
+		{
+			Store.LruOrder.remove(it->Tick);
+			it->Tick = ++d->Tick;
+			Store.LruOrder.insert(it->Tick, Key);
+			Store.Hits++;
+			Data = it->Data;
+			return true;
+		}
+
+		if (d->SpillDir.isEmpty())
+		{
+			Store.Misses++;
+			return false;
+		}
+		SpillFilePath = d->spillFilePath(Kind, Key);
+	}
+
+	// The spill file is read without holding the mutex
+	QFile SpillFile(SpillFilePath);
+	bool SpillHit = SpillFile.open(QIODevice::ReadOnly);
+	if (SpillHit)
+	{
+		Data = SpillFile.readAll();
+	}
+
+	QVector<SpillItem> Spills;
+	{
+		QMutexLocker Lock(&d->Mutex);
+		auto& Store = d->Stores[Kind];
+		if (!SpillHit)
+		{
+			Store.Misses++;
+			return false;
+		}
+
+		Store.SpillHits++;
+		d->store(Kind, Key, Data);
+		d->enforceBudgets(Kind);
+		Spills = d->takeSpills();
+	}
+	d->writeSpills(Spills);
+	return true;
+}
+
+
+//============================================================================
+void CStyleCache::insert(eArtifactKind Kind, const QString& Key,
+	const QByteArray& Data)
+{
+	QVector<SpillItem> Spills;
+	QString StaleSpillFilePath;
+	{
+		QMutexLocker Lock(&d->Mutex);
+		auto& Store = d->Stores[Kind];
+		if (!d->SpillDir.isEmpty())
+		{
+			StaleSpillFilePath = d->spillFilePath(Kind, Key);
+		}
+
+		if (Data.size() > d->Budget || (Store.Budget >= 0 && Data.size() > Store.Budget))
+		{
+			// The artifact does not fit into memory at all
+			d->spill(Kind, Key, Data);
+		}
+		else
+		{
+			d->store(Kind, Key, Data);
+			d->enforceBudgets(Kind);
+		}
+		Spills = d->takeSpills();
+	}
+
+	// The spill file of a replaced artifact contains the old data
+	if (!StaleSpillFilePath.isEmpty())
+	{
+		QFile::remove(StaleSpillFilePath);
+	}
+	d->writeSpills(Spills);
+}
+
+
+//============================================================================
+void CStyleCache::clear()
+{
+	QMutexLocker Lock(&d->Mutex);
+	for (auto& Store : d->Stores)
+	{
+		Store.Entries.clear();
+		Store.LruOrder.clear();
+		Store.Size = 0;
+	}
+	d->Size = 0;
+}
+
+
+//============================================================================
+qint64 CStyleCache::size() const
+{
+	QMutexLocker Lock(&d->Mutex);
+	return d->Size;
+}
+
+
+//============================================================================
+qint64 CStyleCache::size(eArtifactKind Kind) const
+{
+	QMutexLocker Lock(&d->Mutex);
+	return d->Stores[Kind].Size;
+}
+
+
+//============================================================================
+QJsonObject CStyleCache::stats() const
+{
+	QMutexLocker Lock(&d->Mutex);
+	QJsonObject jStats;
+	jStats.insert("budget", double(d->Budget));
+	jStats.insert("bytes", double(d->Size));
+	jStats.insert("spill_dir", d->SpillDir);
+	for (int i = 0; i < ArtifactKindCount; ++i)
+	{
+		const auto& Store = d->Stores[i];
+		QJsonObject jKind;
+		jKind.insert("entries", Store.Entries.size());
+		jKind.insert("bytes", double(Store.Size));
+		jKind.insert("budget", double(Store.Budget));
+		jKind.insert("hits", double(Store.Hits));
+		jKind.insert("spill_hits", double(Store.SpillHits));
+		jKind.insert("misses", double(Store.Misses));
+		jKind.insert("evictions", double(Store.Evictions));
+		jKind.insert("spills", double(Store.Spills));
+		jStats.insert(kindName(static_cast<eArtifactKind>(i)), jKind);
+	}
+	return jStats;
+}
+
+
+//============================================================================
+void CStyleCache::resetStats()
+{
+	QMutexLocker Lock(&d->Mutex);
+	for (auto& Store : d->Stores)
+	{
+		Store.Hits = 0;
+		Store.SpillHits = 0;
+		Store.Misses = 0;
+		Store.Evictions = 0;
+		Store.Spills = 0;
+	}
+}
+
+
+//============================================================================
+QString CStyleCache::kindName(eArtifactKind Kind)
+{
+	switch (Kind)
+	{
+	case StylesheetArtifact: return "stylesheet";
+	case ResourceArtifact: return "resource";
+	case RasterArtifact: return "raster";
+	default: break;
+	}
+
+	return QString();
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleCache.cpp
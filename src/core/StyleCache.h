@@ -0,0 +1,155 @@
+#ifndef StyleCacheH
+#define StyleCacheH
+//============================================================================
+/// \file   StyleCache.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStyleCache class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+#include <QByteArray>
+
+class QJsonObject;
+
+namespace acss
+{
+struct StyleCachePrivate;
+
+/**
+ * Memory budgeted cache for generated style artifacts.
+ * The cache stores the artifacts (rendered stylesheets, recolored SVG
+ * resources, rasterized icons) of recently used themes as byte
+ * arrays, so that switching back to a recent theme does not require the
+ * regeneration of the artifacts.
+ * Each artifact kind has its own least recently used list. If the total size
+ * of all artifacts exceeds the budget() or if the size of one kind exceeds
+ * its kindBudget(), then the least recently used artifacts are evicted. If a
+ * spill directory has been set, evicted artifacts are written to disk and
+ * reloaded from there on the next access. The spill files are deleted if the
+ * artifact is replaced, if the spill directory changes and if the cache is
+ * destroyed.
+ * The keys of the artifacts need to contain a hash of all data the artifact
+ * has been generated from, so that a spilled artifact is never returned for
+ * changed source data.
+ * All functions are thread safe.
+ */
+class CStyleCache
+{
+private:
+	StyleCachePrivate* d; ///< private data (pimpl)
+	friend struct StyleCachePrivate;
+
+public:
+	enum eArtifactKind
+	{
+		StylesheetArtifact,
+		ResourceArtifact,
+		RasterArtifact,
+		ArtifactKindCount
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CStyleCache();
+
+	/**
+	 * Destructor
+	 */
+	~CStyleCache();
+
+	CStyleCache(const CStyleCache&) = delete;
+	CStyleCache& operator=(const CStyleCache&) = delete;
+
+	/**
+	 * Sets the maximum number of bytes of all artifacts kept in memory.
+	 * The default budget is 8 MB. A budget of 0 disables the in memory cache.
+	 */
+	void setBudget(qint64 Bytes);
+
+	/**
+	 * Returns the memory budget of the cache
+	 */
+	qint64 budget() const;
+
+	/**
+	 * Sets the maximum number of bytes for the artifacts of the given kind.
+	 * A value < 0 (the default) means that the kind is only limited by the
+	 * total budget().
+	 */
+	void setKindBudget(eArtifactKind Kind, qint64 Bytes);
+
+	/**
+	 * Returns the memory budget of the given artifact kind
+	 */
+	qint64 kindBudget(eArtifactKind Kind) const;
+
+	/**
+	 * Sets the directory for evicted artifacts.
+	 * If the path is empty (the default), evicted artifacts are dropped.
+	 * The spill files in the previous directory and stale spill files in the
+	 * new directory are deleted. The cache only uses one sub directory per
+	 * artifact kind, so other content of the directory is not touched.
+	 */
+	void setSpillDirPath(const QString& Path);
+
+	/**
+	 * Returns the directory for evicted artifacts
+	 */
+	QString spillDirPath() const;
+
+	/**
+	 * Looks up the artifact with the given key.
+	 * Returns true and assigns the artifact to Data, if the artifact is in
+	 * memory or in the spill directory.
+	 */
+	bool find(eArtifactKind Kind, const QString& Key, QByteArray& Data);
+
+	/**
+	 * Inserts or replaces the artifact with the given key and evicts the
+	 * least recently used artifacts, if the budget is exceeded.
+	 * A spill file of a replaced artifact is deleted.
+	 */
+	void insert(eArtifactKind Kind, const QString& Key, const QByteArray& Data);
+
+	/**
+	 * Removes all artifacts from memory. Spilled artifacts are not removed.
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of bytes of all artifacts in memory
+	 */
+	qint64 size() const;
+
+	/**
+	 * Returns the number of bytes of all artifacts of the given kind in memory
+	 */
+	qint64 size(eArtifactKind Kind) const;
+
+	/**
+	 * Returns the cache statistics.
+	 * The object contains the budget, the total size and one object per
+	 * artifact kind with the number of entries, the size in bytes and the
+	 * number of hits, spill hits, misses, evictions and spills.
+	 */
+	QJsonObject stats() const;
+
+	/**
+	 * Resets the hit, miss and eviction counters
+	 */
+	void resetStats();
+
+	/**
+	 * Returns the name of the given artifact kind, i.e. "stylesheet"
+	 */
+	static QString kindName(eArtifactKind Kind);
+}; // class CStyleCache
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleCacheH
@@ -0,0 +1,321 @@
+//============================================================================
+/// \file   StylePipeline.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStylePipeline class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StylePipeline.h>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+namespace acss
+{
+/**
+ * Internal stage data
+ */
+struct PipelineStage
+{
+	CStylePipeline::StageResult Result;
+	CStylePipeline::StageFunction Function;
+	QVector<int> Dependencies;
+	CStylePipeline::eThreadAffinity Affinity = CStylePipeline::AnyThread;
+	bool Started = false;
+	bool Finished = false;
+};
+
+
+/**
+ * Runnable that executes one stage in the thread pool
+ */
+class CStageRunnable : public QRunnable
+{
+public:
+	CStageRunnable(StylePipelinePrivate* Pipeline, int Stage)
+		: Pipeline(Pipeline), Stage(Stage) {}
+
+	virtual void run() override;
+
+private:
+	StylePipelinePrivate* Pipeline;
+	int Stage;
+};
+
+
+/**
+ * Private data class of CStylePipeline class (pimpl)
+ */
+struct StylePipelinePrivate
+{
+	QVector<PipelineStage> Stages;
+	QMutex Mutex;
+	QWaitCondition StageFinished;
+	QQueue<int> CallerQueue;
+	CStylePipeline::StageFunction CancellationCheck;
+	QStringList UnknownDependencies;
+	bool Cancelled = false;
+	int FinishedCount = 0;
+	qint64 ElapsedNs = 0;
+
+	/**
+	 * Returns the thread pool for the pipeline stages.
+	 * A dedicated pool is used, so that pipelines that are started from
+	 * threads of the global thread pool can not starve
+	 */
+	static QThreadPool* threadPool();
+
+	/**
+	 * Executes the stage with the given index and stores the result.
+	 * Must be called without the mutex locked.
+	 */
+	void execute(int Index);
+
+	/**
+	 * Starts or skips all stages whose dependencies are finished.
+	 * Must be called with the mutex locked.
+	 */
+	void scheduleReadyStages();
+};// struct StylePipelinePrivate
+
+
+//============================================================================
+void CStageRunnable::run()
+{
+	Pipeline->execute(Stage);
+}
+
+
+//============================================================================
+QThreadPool* StylePipelinePrivate::threadPool()
+{
+	static QThreadPool Pool;
+	return &Pool;
+}
+
+
+//============================================================================
+void StylePipelinePrivate::execute(int Index)
+{
+	QElapsedTimer Timer;
+	Timer.start();
+	bool Success = Stages.at(Index).Function();
+	auto ElapsedNs = Timer.nsecsElapsed();
+
+	QMutexLocker Lock(&Mutex);
+	auto& Stage = Stages[Index];
+	Stage.Result.Executed = true;
+	Stage.Result.Success = Success;
+	Stage.Result.ElapsedNs = ElapsedNs;
+	Stage.Finished = true;
+	FinishedCount++;
+	StageFinished.wakeAll();
+}
+
+
+//============================================================================
+void StylePipelinePrivate::scheduleReadyStages()
+{
+	if (!Cancelled && CancellationCheck)
+	{
+		Cancelled = CancellationCheck();
+	}
+
+	bool Changed = true;
+	while (Changed)
+	{
+		Changed = false;
+		for (int i = 0; i < Stages.size(); ++i)
+		{
+			auto& Stage = Stages[i];
+			if (Stage.Started)
+			{
+				continue;
+			}
+
+			bool Ready = true;
+			bool DependencyFailed = false;
+			for (auto Dependency : Stage.Dependencies)
+			{
+				const auto& DependencyStage = Stages[Dependency];
+				Ready = Ready && DependencyStage.Finished;
+				DependencyFailed = DependencyFailed || (DependencyStage.Finished
+					&& !DependencyStage.Result.Success);
+			}
+
+			if (DependencyFailed || Cancelled)
+			{
+				// Skip this stage - this may make other stages ready, so
+				// we need another pass
+				Stage.Started = true;
+				Stage.Finished = true;
+				FinishedCount++;
+				Changed = true;
+			}
+			else if (Ready)
+			{
+				Stage.Started = true;
+				if (Stage.Affinity == CStylePipeline::CallerThread)
+				{
+					CallerQueue.enqueue(i);
+				}
+				else
+				{
+					threadPool()->start(new CStageRunnable(this, i));
+				}
+			}
+		}
+	}
+}
+
+
+//============================================================================
+CStylePipeline::CStylePipeline() :
+	d(new StylePipelinePrivate())
+{
+
+}
+
+
+//============================================================================
+CStylePipeline::~CStylePipeline()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CStylePipeline::addStage(const QString& Name, const StageFunction& Function,
+	const QStringList& Dependencies, eThreadAffinity Affinity)
+{
+	PipelineStage Stage;
+	Stage.Result.Name = Name;
+	Stage.Function = Function;
+	Stage.Affinity = Affinity;
+	for (const auto& Dependency : Dependencies)
+	{
+		int DependencyIndex = -1;
+		for (int i = 0; i < d->Stages.size(); ++i)
+		{
+			if (d->Stages[i].Result.Name == Dependency)
+			{
+				DependencyIndex = i;
+				break;
+			}
+		}
+
+		// Ignoring the dependency would run the stage too early, so the
+		// pipeline refuses to run instead
+		if (DependencyIndex < 0)
+		{
+			qWarning() << "Pipeline stage" << Name << "depends on unknown stage"
+				<< Dependency;
+			d->UnknownDependencies.append(Dependency);
+			continue;
+		}
+		Stage.Dependencies.append(DependencyIndex);
+	}
+	d->Stages.append(Stage);
+}
+
+
+//============================================================================
+void CStylePipeline::setCancellationCheck(const StageFunction& Function)
+{
+	d->CancellationCheck = Function;
+}
+
+
+//============================================================================
+bool CStylePipeline::wasCancelled() const
+{
+	return d->Cancelled;
+}
+
+
+//============================================================================
+bool CStylePipeline::run()
+{
+	QElapsedTimer Timer;
+	Timer.start();
+	for (auto& Stage : d->Stages)
+	{
+		Stage.Result = StageResult{Stage.Result.Name};
+		Stage.Started = false;
+		Stage.Finished = false;
+	}
+	d->FinishedCount = 0;
+	d->Cancelled = false;
+	d->CallerQueue.clear();
+	if (!d->UnknownDependencies.isEmpty())
+	{
+		qWarning() << "Pipeline not started because of unknown stages"
+			<< d->UnknownDependencies;
+		d->ElapsedNs = Timer.nsecsElapsed();
+		return false;
+	}
+
+	QMutexLocker Lock(&d->Mutex);
+	while (d->FinishedCount < d->Stages.size())
+	{
+		d->scheduleReadyStages();
+		if (!d->CallerQueue.isEmpty())
+		{
+			auto Index = d->CallerQueue.dequeue();
+			Lock.unlock();
+			d->execute(Index);
+			Lock.relock();
+		}
+		else if (d->FinishedCount < d->Stages.size())
+		{
+			d->StageFinished.wait(&d->Mutex);
+		}
+	}
+	d->ElapsedNs = Timer.nsecsElapsed();
+	if (d->Cancelled)
+	{
+		return false;
+	}
+
+	for (const auto& Stage : d->Stages)
+	{
+		if (!Stage.Result.Success)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+//============================================================================
+QVector<CStylePipeline::StageResult> CStylePipeline::results() const
+{
+	QVector<StageResult> Results;
+	for (const auto& Stage : d->Stages)
+	{
+		Results.append(Stage.Result);
+	}
+	return Results;
+}
+
+
+//============================================================================
+qint64 CStylePipeline::elapsedNs() const
+{
+	return d->ElapsedNs;
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StylePipeline.cpp
@@ -0,0 +1,125 @@
+#ifndef StylePipelineH
+#define StylePipelineH
+//============================================================================
+/// \file   StylePipeline.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStylePipeline class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <functional>
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace acss
+{
+struct StylePipelinePrivate;
+
+/**
+ * Small scheduler that runs the stages of a style operation as a dependency
+ * graph.
+ * Each stage has a name, a function and the list of stages it depends on.
+ * A stage is started as soon as all of its dependencies finished
+ * successfully. Independent stages run concurrently in a thread pool.
+ * Stages with the CallerThread affinity (i.e. all stages that access the
+ * QApplication) are executed one after another in the thread that called
+ * run(). If a stage fails, all stages that depend on it are skipped.
+ * If a cancellation check is set and returns true, then no further stages
+ * are started and run() returns as soon as the running stages finished.
+ * \code
+ * CStylePipeline Pipeline;
+ * Pipeline.addStage("json", [&]{return parseJson();});
+ * Pipeline.addStage("fonts", [&]{return addFonts();}, {"json"}, CStylePipeline::CallerThread);
+ * Pipeline.addStage("template", [&]{return compileTemplate();}, {"json"});
+ * Pipeline.run();
+ * \endcode
+ */
+class CStylePipeline
+{
+private:
+	StylePipelinePrivate* d; ///< private data (pimpl)
+	friend struct StylePipelinePrivate;
+
+public:
+	using StageFunction = std::function<bool()>;
+
+	enum eThreadAffinity
+	{
+		AnyThread,   ///< the stage may run in a worker thread
+		CallerThread ///< the stage runs in the thread that called run()
+	};
+
+	/**
+	 * Result and execution time of a single stage
+	 */
+	struct StageResult
+	{
+		QString Name;
+		bool Executed = false;
+		bool Success = false;
+		qint64 ElapsedNs = 0;
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CStylePipeline();
+
+	/**
+	 * Destructor
+	 */
+	~CStylePipeline();
+
+	CStylePipeline(const CStylePipeline&) = delete;
+	CStylePipeline& operator=(const CStylePipeline&) = delete;
+
+	/**
+	 * Adds a stage to the pipeline. All dependencies need to be added before
+	 * the stage that depends on them. An unknown dependency is reported
+	 * with a warning and run() refuses to execute the pipeline.
+	 */
+	void addStage(const QString& Name, const StageFunction& Function,
+		const QStringList& Dependencies = QStringList(),
+		eThreadAffinity Affinity = AnyThread);
+
+	/**
+	 * Sets a function that is evaluated before stages are started. If the
+	 * function returns true, all stages that have not been started yet are
+	 * skipped. Long running stages should poll the same condition to
+	 * finish early.
+	 */
+	void setCancellationCheck(const StageFunction& Function);
+
+	/**
+	 * Returns true, if the last run has been cancelled
+	 */
+	bool wasCancelled() const;
+
+	/**
+	 * Runs all stages and blocks until all stages are finished.
+	 * Returns true, if all stages have been executed successfully.
+	 * Returns false without executing any stage, if a stage has an unknown
+	 * dependency.
+	 */
+	bool run();
+
+	/**
+	 * Returns the results of all stages of the last run in the order the
+	 * stages have been added
+	 */
+	QVector<StageResult> results() const;
+
+	/**
+	 * Returns the elapsed time of the last run in nanoseconds
+	 */
+	qint64 elapsedNs() const;
+}; // class CStylePipeline
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StylePipelineH
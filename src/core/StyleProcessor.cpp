@@ -0,0 +1,2566 @@
+//============================================================================
+/// \file   StyleProcessor.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStyleProcessor class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleProcessor.h>
+#include <StyleCache.h>
+#include <StylePipeline.h>
+#include <StyleSchema.h>
+#include <StyleTemplate.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <QMap>
+#include <QHash>
+#include <QXmlStreamReader>
+#include <QFile>
+#include <QDebug>
+#include <QDir>
+#include <QRegularExpression>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+namespace acss
+{
+/**
+ * Aggregated execution times of a pipeline stage
+ */
+struct StageMetric
+{
+	qint64 Count = 0;
+	qint64 TotalNs = 0;
+	qint64 LastNs = 0;
+	qint64 MaxNs = 0;
+
+	void add(qint64 Ns)
+	{
+		Count++;
+		TotalNs += Ns;
+		LastNs = Ns;
+		MaxNs = std::max(MaxNs, Ns);
+	}
+};
+
+
+/**
+ * Snapshot of all data that is required to generate the resources and the
+ * stylesheet of one generation epoch.
+ * Each generation works on its own snapshot, so theme changes in the calling
+ * thread do not interfere with a generation that runs in a worker thread.
+ */
+struct GenerationContext
+{
+	int Epoch = 0;
+	const QAtomicInt* CurrentEpoch = nullptr;
+	CStyleCache* Cache = nullptr;
+	QMap<QString, QString> ThemeVariables;
+	QJsonObject Resources;
+	QFileInfoList ResourceEntries;
+	QString OutputPath;
+	CStyleTemplate Template;
+	QString TemplateFilePath;
+	QDateTime TemplateModified;
+	QString Stylesheet;
+	QVector<CStylePipeline::StageResult> StageResults;
+	qint64 ElapsedNs = 0;
+	bool Success = false;
+	bool Cancelled = false;
+	bool ApplyRequested = false;// passed to onStylesheetUpdateFinished()
+	bool CacheStylesheet = true;// false in lean mode
+	ResourceProcessor ResourceProcessing;
+
+	/**
+	 * Returns true, if a newer generation epoch has been started and the
+	 * results of this generation are not required anymore
+	 */
+	bool isStale() const
+	{
+		return CurrentEpoch->loadAcquire() != Epoch;
+	}
+};
+
+
+/**
+ * Data of a style that is loaded by setCurrentStyle() or openStyle().
+ * The loading stages write into the context and the data is taken over
+ * into the style processor in its own thread.
+ */
+struct StyleLoadContext
+{
+	QString Style;
+	QString StylePath;
+	QString Theme;
+	QStringList Themes;
+	QJsonObject JsonStyleParam;
+	QJsonObject JsonResources;
+	QString StyleName;
+	QString IconFile;
+	QMap<QString, QString> StyleVariables;
+	QMap<QString, QString> ThemeColors;
+	QMap<QString, QString> ThemeVariables;
+	QMap<QString, QMap<QString, QString>> VariableOverrides;
+	QFileInfoList ResourceEntries;
+	CStyleTemplate Template;
+	QString TemplateFilePath;
+	QDateTime TemplateModified;
+	GenerationContext Generation;
+	QVector<CStylePipeline::StageResult> StageResults;
+	qint64 ElapsedNs = 0;
+	bool Success = false;
+};
+
+
+/**
+ * Theme data and stylesheet of a scope generated by generateScopedStyle()
+ */
+struct ScopeData
+{
+	QString Theme;
+	QMap<QString, QString> ThemeColors;
+	QString Stylesheet;
+};
+
+
+template <class Key, class T>
+static void insertIntoMap(QMap<Key, T>& Map, const QMap<Key, T> &map)
+{
+#if QT_VERSION >= 0x050F00
+    Map.insert(map);
+#else
+    for (auto itc = map.constBegin(); itc != map.constEnd(); ++itc)
+    {
+        Map.insert(itc.key(), itc.value());
+    }
+#endif
+}
+
+
+/**
+ * Interned theme variable names.
+ * All themes of a style define the same variables, so each name is created
+ * only once and the parsed themes share its string data. The lookup uses the
+ * raw UTF-8 bytes of the theme file and does not allocate for known names.
+ */
+struct ThemeVariableNames
+{
+	QMutex Mutex;
+	QHash<QByteArray, QString> Names;
+
+	/**
+	 * Returns the interned string for the given name. The Mutex is only
+	 * locked for the lookup, so themes can be parsed in parallel.
+	 */
+	QString intern(const char* Name, int Size)
+	{
+		QMutexLocker Lock(&Mutex);
+		auto it = Names.constFind(QByteArray::fromRawData(Name, Size));
+		if (it != Names.constEnd())
+		{
+			return it.value();
+		}
+		auto String = QString::fromUtf8(Name, Size);
+		Names.insert(QByteArray(Name, Size), String);
+		return String;
+	}
+};
+
+
+/**
+ * Scanner for the fixed schema of the theme files - a <resources> element
+ * with a flat list of <color name="...">value</color> elements, comments and
+ * an optional XML declaration.
+ * The scanner works directly on the mapped file data. It returns false for
+ * anything it does not understand (entities, CDATA, other elements or
+ * attributes, an encoding other than UTF-8 in the XML declaration, errors)
+ * and the caller then falls back to QXmlStreamReader, which also produces
+ * the error messages.
+ */
+class CThemeXmlScanner
+{
+private:
+	const char* Pos;
+	const char* End;
+
+	bool startsWith(const char* Text) const
+	{
+		auto p = Pos;
+		for (; *Text; ++Text, ++p)
+		{
+			if (p == End || *p != *Text)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool skip(const char* Text)
+	{
+		auto Length = qstrlen(Text);
+		if (!startsWith(Text))
+		{
+			return false;
+		}
+		Pos += Length;
+		return true;
+	}
+
+	void skipSpace()
+	{
+		while (Pos != End && (*Pos == ' ' || *Pos == '\n' || *Pos == '\r' || *Pos == '\t'))
+		{
+			++Pos;
+		}
+	}
+
+	bool skipUntil(const char* Text)
+	{
+		for (; Pos != End; ++Pos)
+		{
+			if (skip(Text))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Skips whitespace, comments and processing instructions
+	 */
+	bool skipMisc()
+	{
+		for (;;)
+		{
+			skipSpace();
+			if (skip("<!--"))
+			{
+				if (!skipUntil("-->"))
+				{
+					return false;
+				}
+			}
+			else if (startsWith("<?"))
+			{
+				if (!skipUntil("?>"))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				return true;
+			}
+		}
+	}
+
+	/**
+	 * Returns false, if the XML declaration at the current position
+	 * specifies an encoding other than UTF-8
+	 */
+	bool isUtf8Declaration() const
+	{
+		static const char Xml[] = "<?xml";
+		static const char Encoding[] = "encoding";
+		if (!startsWith(Xml))
+		{
+			return true;
+		}
+
+		auto DeclEnd = Pos;
+		for (; DeclEnd + 1 < End && !(DeclEnd[0] == '?' && DeclEnd[1] == '>'); ++DeclEnd) {}
+		auto Decl = QByteArray::fromRawData(Pos, int(DeclEnd - Pos));
+		auto Index = Decl.indexOf(Encoding);
+		if (Index < 0)
+		{
+			return true;
+		}
+
+		// encoding = "name" or encoding = 'name'
+		auto Value = Decl.mid(Index + int(sizeof(Encoding)) - 1).trimmed();
+		if (!Value.startsWith('='))
+		{
+			return false;
+		}
+		Value = Value.mid(1).trimmed();
+		if (Value.isEmpty() || (Value[0] != '"' && Value[0] != '\''))
+		{
+			return false;
+		}
+		auto ValueEnd = Value.indexOf(Value[0], 1);
+		return ValueEnd > 0 && (Value.mid(1, ValueEnd - 1).toLower() == "utf-8");
+	}
+
+	/**
+	 * Returns the end of the text that starts at the current position. The
+	 * text ends at the given delimiter. Returns nullptr for references
+	 * and markup characters that require a real XML parser.
+	 */
+	const char* scanText(char Delimiter) const
+	{
+		auto p = static_cast<const char*>(memchr(Pos, Delimiter, End - Pos));
+		if (!p || memchr(Pos, '&', p - Pos) || (Delimiter != '<' && memchr(Pos, '<', p - Pos)))
+		{
+			return nullptr;
+		}
+		return p;
+	}
+
+public:
+	CThemeXmlScanner(const char* Data, qint64 Size) : Pos(Data), End(Data + Size) {}
+
+	bool scan(ThemeVariableNames& Names, QMap<QString, QString>& Variables)
+	{
+		skip("\xEF\xBB\xBF");
+		if (!isUtf8Declaration() || !skipMisc() || !skip("<resources"))
+		{
+			return false;
+		}
+		skipSpace();
+		if (!skip(">"))
+		{
+			return false;
+		}
+
+		for (;;)
+		{
+			if (!skipMisc())
+			{
+				return false;
+			}
+
+			if (skip("</resources"))
+			{
+				skipSpace();
+				return skip(">") && skipMisc() && Pos == End;
+			}
+
+			if (!skip("<color") || Pos == End || (*Pos != ' ' && *Pos != '\t'
+				&& *Pos != '\n' && *Pos != '\r'))
+			{
+				return false;
+			}
+			skipSpace();
+			if (!skip("name"))
+			{
+				return false;
+			}
+			skipSpace();
+			if (!skip("="))
+			{
+				return false;
+			}
+			skipSpace();
+			if (Pos == End || (*Pos != '"' && *Pos != '\''))
+			{
+				return false;
+			}
+			char Quote = *Pos++;
+			auto NameEnd = scanText(Quote);
+			if (!NameEnd || NameEnd == Pos)
+			{
+				return false;
+			}
+			auto Name = Pos;
+			Pos = NameEnd + 1;
+			skipSpace();
+			if (!skip(">"))
+			{
+				return false;
+			}
+
+			auto ValueEnd = scanText('<');
+			if (!ValueEnd || ValueEnd == Pos)
+			{
+				return false;
+			}
+			auto Value = Pos;
+			Pos = ValueEnd;
+			if (!skip("</color"))
+			{
+				return false;
+			}
+			skipSpace();
+			if (!skip(">"))
+			{
+				return false;
+			}
+
+			Variables.insert(Names.intern(Name, int(NameEnd - Name)),
+				QString::fromUtf8(Value, int(ValueEnd - Value)));
+		}
+	}
+};
+
+
+/**
+ * Private data class of CStyleProcessor class (pimpl)
+ */
+struct StyleProcessorPrivate
+{
+	CStyleProcessor *_this;
+	QString StylesDir;
+	QString OutputDir;
+	QMap<QString, QString> StyleVariables;
+	QMap<QString, QString> ThemeColors;
+	QMap<QString, QString> ThemeVariables;// theme variables contains StyleVariables and ThemeColors
+	QString Stylesheet;
+	QByteArray StylesheetHash;
+	QMap<QString, QString> StylesheetVariables;// variables of the last generation
+	CStyleTemplate StylesheetTemplate;// template of the last generation
+	QString StylesheetImageSuffix;// image suffix of the last generation
+	QString CurrentStyle;
+	QString CurrentTheme;
+	QString StyleName;
+	QString IconFile;
+	QJsonObject JsonStyleParam;
+	QJsonObject JsonResources;
+	QString ErrorString;
+	CStyleProcessor::eError Error;
+	QMutex ErrorMutex;
+	CStyleTemplate Template;
+	QString TemplateFilePath;
+	QDateTime TemplateModified;
+	QFileInfoList ResourceEntries;
+	QMap<QString, StageMetric> StageMetrics;
+	int OuterOperations = 0;// depth of beginOperation() calls
+	QMap<QString, qint64> NestedOperationNs;
+	CStyleCache Cache;
+	QAtomicInt Epoch;
+	QAtomicInt ScopeEpoch;
+	QMap<QString, ScopeData> Scopes;
+	QMutex GenerationMutex;
+	ThemeVariableNames VariableNames;
+	QThreadPool AsyncPool;
+	bool AsyncUpdateRunning = false;
+	bool AsyncUpdatePending = false;
+	bool PendingApplyRequested = false;
+	int StyleOpensRunning = 0;// openStyle() calls that did not finish yet
+	QStringList Styles;
+	QStringList Themes;
+	QByteArray EmittedStylesheetHash;
+	QByteArray EmittedThemeColorsHash;
+	QString EmittedStyle;
+	QString EmittedTheme;
+	bool LastUpdateChangedStyle = false;
+	int UpdateSerial = 0;// counts the synchronous updates
+	bool LeanMode = false;
+	QMap<QString, QMap<QString, QString>> VariableOverrides;// key: style/theme
+	QString VariableOverridesFilePath;
+
+	/**
+	 * Private data constructor
+	 */
+	StyleProcessorPrivate(CStyleProcessor *_public);
+
+	/**
+	 * Store the given stylesheet in the given output path
+	 */
+	bool storeStylesheet(const QString& Stylesheet, const QString& Filename,
+		const QString& OutputPath);
+
+	/**
+	 * Parse a list of theme variables
+	 */
+	bool parseVariablesFromXml(QXmlStreamReader& s, const QString& VariableTagName,
+		QMap<QString, QString>& Variable);
+
+	/**
+	 * Parse the theme file for
+	 */
+	bool parseThemeFile(const QString& ThemeFilename);
+
+	/**
+	 * Reads the color variables from the given theme file and merges them
+	 * with the given style variables
+	 */
+	bool readThemeFile(const QString& ThemeFileName,
+		const QMap<QString, QString>& StyleVariables,
+		QMap<QString, QString>& ThemeColors, QMap<QString, QString>& ThemeVariables);
+
+	/**
+	 * Returns the key of the given style and theme in VariableOverrides
+	 */
+	static QString overridesKey(const QString& Style, const QString& Theme)
+	{
+		return Style + "/" + Theme;
+	}
+
+	/**
+	 * Applies the given variable overrides to the theme variables and to the
+	 * theme colors that are defined in the theme file
+	 */
+	static void applyVariableOverrides(const QMap<QString, QString>& Overrides,
+		QMap<QString, QString>& ThemeColors, QMap<QString, QString>& ThemeVariables);
+
+	/**
+	 * Reloads the current theme file and applies the overrides of the current
+	 * style and theme
+	 */
+	bool reloadCurrentTheme();
+
+	/**
+	 * Restores the values of the given variables from the current theme
+	 * file. All other variables keep their values, including the ones that
+	 * have been changed via setThemeVariableValue(). Variables that are not
+	 * defined by the style or the theme file are removed.
+	 */
+	bool restoreThemeValues(const QStringList& VariableIds);
+
+	/**
+	 * Removes all scopes of the current style with their icon search paths
+	 * and their resource folders
+	 */
+	void clearScopes();
+
+	/**
+	 * Writes the variable overrides into the overrides file
+	 */
+	bool saveVariableOverrides();
+
+	/**
+	 * Parse the style JSON file of the style in the given context
+	 */
+	bool parseStyleJsonFile(StyleLoadContext& Context);
+
+	/**
+	 * Reads the style JSON file of the style in the given folder into Json
+	 */
+	bool readStyleJsonFile(const QString& StylePath, QJsonObject& Json);
+
+	/**
+	 * Adds the stages that load the theme list, the style JSON file, the
+	 * resource index and the stylesheet template to the given pipeline
+	 */
+	void addStyleLoadStages(CStylePipeline& Pipeline, StyleLoadContext& Context);
+
+	/**
+	 * Takes over the data of the parsed style JSON file
+	 */
+	void applyStyleJson(const StyleLoadContext& Context);
+
+	/**
+	 * Takes over the theme list, the resource index and the template
+	 */
+	void applyStyleFiles(const StyleLoadContext& Context);
+
+	/**
+	 * Called in the thread of the style processor if an asynchronous
+	 * openStyle() operation finished
+	 */
+	void finishStyleOpen(const StyleLoadContext& Context);
+
+	/**
+	 * Drops the stylesheet and the style parameters in lean mode.
+	 * Both are regenerated on demand.
+	 */
+	void releaseRetainedData();
+
+	/**
+	 * Loads and compiles the stylesheet template of the style in the given
+	 * context
+	 */
+	bool loadTemplate(StyleLoadContext& Context);
+
+	/**
+	 * Renders the compiled template of the given context into its stylesheet.
+	 * The template is reloaded, if the template file has been modified.
+	 */
+	bool renderStylesheet(GenerationContext& Context);
+
+	/**
+	 * Lists the SVG resource templates of the style in the given folder
+	 */
+	static QFileInfoList indexResources(const QString& StylePath);
+
+	/**
+	 * Lists the themes of the style in the given folder
+	 */
+	static QStringList listThemes(const QString& StylePath);
+
+	/**
+	 * Starts a new generation epoch and returns a snapshot of the current
+	 * theme data for the new generation.
+	 * All generations of older epochs become stale and stop as soon as
+	 * possible.
+	 */
+	GenerationContext createGenerationContext();
+
+	/**
+	 * Returns a generation context for the given scope. Scope generations
+	 * run synchronously and are never cancelled.
+	 */
+	GenerationContext createScopeContext(const QString& Scope,
+		const QMap<QString, QString>& ThemeVariables);
+
+	/**
+	 * Adds one stage per resource variant to the given pipeline.
+	 * The stage names are prefixed with the given prefix.
+	 */
+	void addResourceStages(CStylePipeline& Pipeline, const QString& Prefix,
+		GenerationContext& Context);
+
+	/**
+	 * Adds the resource stages and the stylesheet render and export stages
+	 * to the given pipeline
+	 */
+	void addGenerationStages(CStylePipeline& Pipeline, GenerationContext& Context);
+
+	/**
+	 * Runs the given pipeline and stores the results in the given context.
+	 * The pipeline is cancelled, if the context becomes stale.
+	 */
+	bool runGeneration(CStylePipeline& Pipeline, GenerationContext& Context);
+
+	/**
+	 * Takes over the stylesheet and the template of the given generation
+	 * and records its metrics with the given prefix
+	 */
+	void applyGeneration(const GenerationContext& Context, const QString& Prefix);
+
+	/**
+	 * Adds the given stage timings to the stage metrics.
+	 * The total time is stored with the Prefix as key.
+	 */
+	void recordMetrics(const QString& Prefix,
+		const QVector<CStylePipeline::StageResult>& Results, qint64 ElapsedNs);
+
+	/**
+	 * Generate the resources for the variuous states
+	 */
+	bool generateResourcesFor(const QString& SubDir,
+		const QJsonObject& JsonObject, const GenerationContext& Context);
+
+	/**
+	 * Starts the generation of the resources and the stylesheet in the
+	 * asynchronous update thread
+	 */
+	void startAsyncUpdate(bool ApplyRequested);
+
+	/**
+	 * Starts an asynchronous update or queues it, if a style open or an
+	 * update is running
+	 */
+	void requestAsyncUpdate(bool ApplyRequested);
+
+	/**
+	 * Called in the thread of the style processor if an asynchronous
+	 * generation finished
+	 */
+	void finishAsyncUpdate(const GenerationContext& Context);
+
+	/**
+	 * Replace the in the given content the template color string with the
+	 * theme color string
+	 */
+	void replaceColor(QByteArray& Content, const QString& TemplateColor,
+		const QString& ThemeColor) const;
+
+	/**
+	 * Set error code and error string
+	 */
+	void setError(CStyleProcessor::eError Error, const QString& ErrorString);
+
+	/**
+	 * Convenience function to ease clearing the error
+	 */
+	void clearError()
+	{
+		setError(CStyleProcessor::NoError, QString());
+	}
+};// struct StyleProcessorPrivate
+
+
+//============================================================================
+StyleProcessorPrivate::StyleProcessorPrivate(
+    CStyleProcessor *_public) :
+	_this(_public)
+{
+	// One asynchronous update at a time - a new update is only started
+	// after the stale one has been cancelled
+	AsyncPool.setMaxThreadCount(1);
+}
+
+
+/**
+ * Runnable that executes an asynchronous generation and posts the result
+ * to the thread of the style processor
+ */
+class CGenerationRunnable : public QRunnable
+{
+public:
+	CGenerationRunnable(StyleProcessorPrivate* Processor,
+		const QSharedPointer<GenerationContext>& Context)
+		: Processor(Processor), Context(Context) {}
+
+	virtual void run() override;
+
+private:
+	StyleProcessorPrivate* Processor;
+	QSharedPointer<GenerationContext> Context;
+};
+
+
+/**
+ * Runnable that loads a style asynchronously and generates the stylesheet
+ * for the requested theme
+ */
+class CStyleOpenRunnable : public QRunnable
+{
+public:
+	CStyleOpenRunnable(StyleProcessorPrivate* Processor,
+		const QSharedPointer<StyleLoadContext>& Context)
+		: Processor(Processor), Context(Context) {}
+
+	virtual void run() override;
+
+private:
+	StyleProcessorPrivate* Processor;
+	QSharedPointer<StyleLoadContext> Context;
+};
+
+
+//============================================================================
+void CStyleOpenRunnable::run()
+{
+	auto& Generation = Context->Generation;
+	if (!Generation.isStale())
+	{
+		CStylePipeline Pipeline;
+		Processor->addStyleLoadStages(Pipeline, *Context);
+		auto& Load = *Context;
+		Pipeline.addStage("theme", [this, &Load]()
+		{
+			// Without an explicit theme, the first theme of the style is used
+			if (Load.Theme.isEmpty() && !Load.Themes.isEmpty())
+			{
+				Load.Theme = Load.Themes.first();
+			}
+			if (!Processor->readThemeFile(Load.StylePath + "/themes/" + Load.Theme
+				+ ".xml", Load.StyleVariables, Load.ThemeColors, Load.ThemeVariables))
+			{
+				return false;
+			}
+			Processor->applyVariableOverrides(Load.VariableOverrides.value(
+				StyleProcessorPrivate::overridesKey(Load.Style, Load.Theme)),
+				Load.ThemeColors, Load.ThemeVariables);
+			return true;
+		}, {"themes", "json"});
+		Pipeline.setCancellationCheck([&Generation](){return Generation.isStale();});
+		Context->Success = Pipeline.run();
+		Context->StageResults = Pipeline.results();
+		Context->ElapsedNs = Pipeline.elapsedNs();
+	}
+
+	// The stylesheet generation needs the results of all loading stages, so
+	// it runs after the loading pipeline. Running it as a stage of the
+	// loading pipeline would block a pipeline thread.
+	if (Context->Success && !Generation.isStale())
+	{
+		Generation.ThemeVariables = Context->ThemeVariables;
+		Generation.Resources = Context->JsonResources;
+		Generation.ResourceEntries = Context->ResourceEntries;
+		Generation.Template = Context->Template;
+		Generation.TemplateFilePath = Context->TemplateFilePath;
+		Generation.TemplateModified = Context->TemplateModified;
+		QMutexLocker Lock(&Processor->GenerationMutex);
+		CStylePipeline Pipeline;
+		Processor->addGenerationStages(Pipeline, Generation);
+		Processor->runGeneration(Pipeline, Generation);
+	}
+
+	auto Processor = this->Processor;
+	auto Context = this->Context;
+	QMetaObject::invokeMethod(Processor->_this, [Processor, Context]()
+	{
+		Processor->finishStyleOpen(*Context);
+	}, Qt::QueuedConnection);
+}
+
+
+//============================================================================
+void CGenerationRunnable::run()
+{
+	if (!Context->isStale())
+	{
+		QMutexLocker Lock(&Processor->GenerationMutex);
+		CStylePipeline Pipeline;
+		Processor->addGenerationStages(Pipeline, *Context);
+		Processor->runGeneration(Pipeline, *Context);
+	}
+
+	auto Processor = this->Processor;
+	auto Context = this->Context;
+	QMetaObject::invokeMethod(Processor->_this, [Processor, Context]()
+	{
+		Processor->finishAsyncUpdate(*Context);
+	}, Qt::QueuedConnection);
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::setError(CStyleProcessor::eError Error,
+	const QString& ErrorString)
+{
+	// Errors may be set from pipeline stages in worker threads
+	QMutexLocker Lock(&ErrorMutex);
+	this->Error = Error;
+	this->ErrorString = ErrorString;
+	if (Error != CStyleProcessor::NoError)
+	{
+		qDebug() << "CStyleProcessor Error: " << Error << " " << ErrorString;
+	}
+}
+
+
+//============================================================================
+static QByteArray stringHash(const QString& String)
+{
+	return QCryptographicHash::hash(QByteArray::fromRawData(
+		reinterpret_cast<const char*>(String.constData()),
+		String.size() * int(sizeof(QChar))), QCryptographicHash::Sha1);
+}
+
+
+//============================================================================
+static QByteArray mapHash(const QMap<QString, QString>& Map)
+{
+	QCryptographicHash Hash(QCryptographicHash::Sha1);
+	for (auto itc = Map.constBegin(); itc != Map.constEnd(); ++itc)
+	{
+		Hash.addData(stringHash(itc.key() + ':' + itc.value()));
+	}
+	return Hash.result();
+}
+
+
+//============================================================================
+static qint64 stringBytes(const QString& String)
+{
+	if (String.isNull())
+	{
+		return 0;
+	}
+	return qint64(sizeof(QArrayData)) + (String.capacity() + 1) * qint64(sizeof(QChar));
+}
+
+
+//============================================================================
+static qint64 stringListBytes(const QStringList& List)
+{
+	qint64 Bytes = List.size() * qint64(sizeof(void*));
+	for (const auto& String : List)
+	{
+		Bytes += stringBytes(String);
+	}
+	return Bytes;
+}
+
+
+//============================================================================
+static qint64 mapBytes(const QMap<QString, QString>& Map)
+{
+	qint64 Bytes = 0;
+	for (auto itc = Map.constBegin(); itc != Map.constEnd(); ++itc)
+	{
+		Bytes += stringBytes(itc.key()) + stringBytes(itc.value());
+	}
+	return Bytes;
+}
+
+
+//============================================================================
+static qint64 mapNodeBytesEstimate(const QMap<QString, QString>& Map)
+{
+	// The node layout of QMap is private - a node holds the key, the value,
+	// the tree links and the color
+	return Map.size() * qint64(2 * sizeof(QString) + 4 * sizeof(void*));
+}
+
+
+//============================================================================
+static qint64 fileInfoListBytes(const QFileInfoList& List)
+{
+	// Only the path strings are counted, the private data of QFileInfo is
+	// part of the container overhead estimate
+	qint64 Bytes = List.size() * qint64(sizeof(QFileInfo));
+	for (const auto& Entry : List)
+	{
+		Bytes += stringBytes(Entry.filePath());
+	}
+	return Bytes;
+}
+
+
+//============================================================================
+static qint64 jsonBytes(const QJsonObject& Json)
+{
+	// QJsonObject does not expose its internal storage - the size of the
+	// compact JSON text is a good approximation
+	if (Json.isEmpty())
+	{
+		return 0;
+	}
+	return QJsonDocument(Json).toJson(QJsonDocument::Compact).size() * qint64(sizeof(QChar));
+}
+
+
+//============================================================================
+static void compileTemplateFile(const QString& FilePath, CStyleTemplate& Template,
+	QDateTime& Modified)
+{
+	Template = CStyleTemplate();
+	QFile TemplateFile(FilePath);
+	if (!TemplateFile.open(QIODevice::ReadOnly))
+	{
+		// The missing template is reported by renderStylesheet()
+		return;
+	}
+
+	Modified = QFileInfo(TemplateFile).lastModified();
+	Template.compile(TemplateFile.readAll());
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::loadTemplate(StyleLoadContext& Context)
+{
+	Context.Template = CStyleTemplate();
+	Context.TemplateFilePath.clear();
+	auto CssTemplateFileName = Context.JsonStyleParam.value(styleJsonKey(CssTemplateKey)).toString();
+	if (CssTemplateFileName.isEmpty())
+	{
+		return true;
+	}
+
+	Context.TemplateFilePath = Context.StylePath + "/" + CssTemplateFileName;
+	compileTemplateFile(Context.TemplateFilePath, Context.Template,
+		Context.TemplateModified);
+	return true;
+}
+
+
+//============================================================================
+static QString renderTemplate(const CStyleTemplate& Template,
+	const QMap<QString, QString>& Variables, const QString& Suffix)
+{
+	auto Stylesheet = Template.render(Variables);
+	if (!Suffix.isEmpty())
+	{
+		static const QRegularExpression SvgUrlRegex(
+			"(url\\(\\s*[\"']?icon:[^)\"']*)\\.svg");
+		Stylesheet.replace(SvgUrlRegex, "\\1." + Suffix);
+	}
+	return Stylesheet;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::renderStylesheet(GenerationContext& Context)
+{
+	if (Context.TemplateFilePath.isEmpty())
+	{
+		return true;
+	}
+
+	QFileInfo TemplateFileInfo(Context.TemplateFilePath);
+	if (!TemplateFileInfo.exists())
+	{
+		setError(CStyleProcessor::CssTemplateError, "Stylesheet folder "
+			"does not contain the CSS template file " + TemplateFileInfo.fileName());
+		return false;
+	}
+
+	if (Context.Template.isEmpty()
+	 || TemplateFileInfo.lastModified() != Context.TemplateModified)
+	{
+		compileTemplateFile(Context.TemplateFilePath, Context.Template,
+			Context.TemplateModified);
+	}
+
+	if (Context.isStale())
+	{
+		return false;
+	}
+
+	// In lean mode, the artifact cache would keep the copy of the
+	// stylesheet that the lean mode drops
+	if (!Context.CacheStylesheet)
+	{
+		Context.Stylesheet = renderTemplate(Context.Template, Context.ThemeVariables,
+			Context.ResourceProcessing.StylesheetImageSuffix);
+		return true;
+	}
+
+	// Switching back to a recently used theme takes the stylesheet from the
+	// artifact cache
+	auto Key = Context.TemplateFilePath + ":"
+		+ QString::number(Context.TemplateModified.toMSecsSinceEpoch()) + ":"
+		+ QString::fromLatin1(mapHash(Context.ThemeVariables).toHex()) + ":"
+		+ Context.ResourceProcessing.StylesheetImageSuffix;
+	QByteArray Data;
+	if (Context.Cache->find(CStyleCache::StylesheetArtifact, Key, Data))
+	{
+		Context.Stylesheet = QString::fromUtf8(Data);
+		return true;
+	}
+
+	Context.Stylesheet = renderTemplate(Context.Template, Context.ThemeVariables,
+		Context.ResourceProcessing.StylesheetImageSuffix);
+	Context.Cache->insert(CStyleCache::StylesheetArtifact, Key, Context.Stylesheet.toUtf8());
+	return true;
+}
+
+
+//============================================================================
+bool CStyleProcessor::emitStylesheetChangedIfModified()
+{
+	// Only re-renders of the style and theme of the last emission are
+	// suppressed. A switch is always signalled, even if the new style or
+	// theme renders the same stylesheet
+	auto StylesheetHash = d->StylesheetHash;
+	auto ThemeColorsHash = mapHash(d->ThemeColors);
+	d->LastUpdateChangedStyle = (d->CurrentStyle != d->EmittedStyle)
+		|| (d->CurrentTheme != d->EmittedTheme)
+		|| (StylesheetHash != d->EmittedStylesheetHash)
+		|| (ThemeColorsHash != d->EmittedThemeColorsHash);
+	if (!d->LastUpdateChangedStyle)
+	{
+		return false;
+	}
+
+	d->EmittedStyle = d->CurrentStyle;
+	d->EmittedTheme = d->CurrentTheme;
+	d->EmittedStylesheetHash = StylesheetHash;
+	d->EmittedThemeColorsHash = ThemeColorsHash;
+	emit stylesheetChanged();
+	return true;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::storeStylesheet(const QString& Stylesheet,
+	const QString& Filename, const QString& OutputPath)
+{
+	QDir().mkpath(OutputPath);
+	QString OutputFilename = OutputPath + "/" + Filename;
+	QFile OutputFile(OutputFilename);
+	if (!OutputFile.open(QIODevice::WriteOnly))
+	{
+		setError(CStyleProcessor::CssExportError, "Exporting stylesheet "
+			+ Filename + " caused error: " + OutputFile.errorString());
+		return false;
+	}
+	OutputFile.write(Stylesheet.toUtf8());
+	OutputFile.close();
+	return true;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::parseVariablesFromXml(
+	QXmlStreamReader& s, const QString& TagName, QMap<QString, QString>& Variables)
+{
+	while (s.readNextStartElement())
+	{
+		if (s.name() != TagName)
+		{
+			setError(CStyleProcessor::ThemeXmlError, "Malformed theme "
+				"file - expected tag <" + TagName + "> instead of " + s.name());
+			return false;
+		}
+		auto Name = s.attributes().value("name");
+		if (Name.isEmpty())
+		{
+			setError(CStyleProcessor::ThemeXmlError, "Malformed theme file - "
+				"name attribute missing in <" + TagName + "> tag");
+			return false;
+		}
+
+		auto Value = s.readElementText(QXmlStreamReader::SkipChildElements);
+		if (Value.isEmpty())
+		{
+			setError(CStyleProcessor::ThemeXmlError, "Malformed theme file - "
+				"text of <" + TagName + "> tag is empty");
+			return false;
+		}
+
+		Variables.insert(Name.toString(), Value);
+	}
+
+	return true;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::parseThemeFile(const QString& Theme)
+{
+	return readThemeFile(_this->path(CStyleProcessor::ThemesLocation) + "/" + Theme,
+		StyleVariables, ThemeColors, ThemeVariables);
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::readThemeFile(const QString& ThemeFileName,
+	const QMap<QString, QString>& StyleVariables,
+	QMap<QString, QString>& ThemeColors, QMap<QString, QString>& ThemeVariables)
+{
+	QFile ThemeFile(ThemeFileName);
+	if (!ThemeFile.open(QIODevice::ReadOnly))
+	{
+		setError(CStyleProcessor::ThemeXmlError, "Error opening theme file "
+			+ ThemeFileName + ": " + ThemeFile.errorString());
+		return false;
+	}
+	auto Size = ThemeFile.size();
+	auto Data = (Size > 0) ? ThemeFile.map(0, Size) : nullptr;
+
+	// Fast path for the fixed theme file schema - QXmlStreamReader is only
+	// used for files the scanner does not understand
+	QMap<QString, QString> ColorVariables;
+	if (!Data || !CThemeXmlScanner(reinterpret_cast<const char*>(Data), Size)
+		.scan(VariableNames, ColorVariables))
+	{
+		ColorVariables.clear();
+		auto Buffer = Data ? QByteArray::fromRawData(reinterpret_cast<const char*>(Data),
+			int(Size)) : ThemeFile.readAll();
+		QXmlStreamReader s(Buffer);
+		s.readNextStartElement();
+		if (s.name() != "resources")
+		{
+			setError(CStyleProcessor::ThemeXmlError, "Malformed theme file - "
+				"expected tag <resources> instead of " + s.name());
+			return false;
+		}
+		parseVariablesFromXml(s, "color", ColorVariables);
+	}
+
+	ThemeVariables = StyleVariables;
+        insertIntoMap(ThemeVariables, ColorVariables);
+	ThemeColors = ColorVariables;
+	return true;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::applyVariableOverrides(const QMap<QString, QString>& Overrides,
+	QMap<QString, QString>& ThemeColors, QMap<QString, QString>& ThemeVariables)
+{
+	for (auto itc = Overrides.constBegin(); itc != Overrides.constEnd(); ++itc)
+	{
+		ThemeVariables.insert(itc.key(), itc.value());
+		auto it = ThemeColors.find(itc.key());
+		if (it != ThemeColors.end())
+		{
+			it.value() = itc.value();
+		}
+	}
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::reloadCurrentTheme()
+{
+	if (!parseThemeFile(CurrentTheme + ".xml"))
+	{
+		return false;
+	}
+
+	Epoch.fetchAndAddOrdered(1);
+	applyVariableOverrides(VariableOverrides.value(overridesKey(CurrentStyle,
+		CurrentTheme)), ThemeColors, ThemeVariables);
+	return true;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::restoreThemeValues(const QStringList& VariableIds)
+{
+	QMap<QString, QString> FileColors;
+	QMap<QString, QString> FileVariables;
+	if (!readThemeFile(_this->path(CStyleProcessor::ThemesLocation) + "/"
+		+ CurrentTheme + ".xml", StyleVariables, FileColors, FileVariables))
+	{
+		return false;
+	}
+
+	Epoch.fetchAndAddOrdered(1);
+	for (const auto& VariableId : VariableIds)
+	{
+		auto itv = FileVariables.constFind(VariableId);
+		if (itv == FileVariables.constEnd())
+		{
+			ThemeVariables.remove(VariableId);
+		}
+		else
+		{
+			ThemeVariables.insert(VariableId, itv.value());
+		}
+
+		auto itc = FileColors.constFind(VariableId);
+		if (itc != FileColors.constEnd())
+		{
+			ThemeColors.insert(VariableId, itc.value());
+		}
+	}
+	return true;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::clearScopes()
+{
+	for (const auto& Scope : Scopes.keys())
+	{
+		_this->removeScope(Scope);
+	}
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::saveVariableOverrides()
+{
+	if (VariableOverridesFilePath.isEmpty())
+	{
+		return true;
+	}
+
+	QJsonObject jOverrides;
+	for (auto itc = VariableOverrides.constBegin(); itc != VariableOverrides.constEnd(); ++itc)
+	{
+		QJsonObject jVariables;
+		for (auto itv = itc.value().constBegin(); itv != itc.value().constEnd(); ++itv)
+		{
+			jVariables.insert(itv.key(), itv.value());
+		}
+		jOverrides.insert(itc.key(), jVariables);
+	}
+
+	QSaveFile OverridesFile(VariableOverridesFilePath);
+	if (!OverridesFile.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "Failed to write variable overrides file" << VariableOverridesFilePath;
+		return false;
+	}
+	OverridesFile.write(QJsonDocument(jOverrides).toJson(QJsonDocument::Compact));
+	return OverridesFile.commit();
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::readStyleJsonFile(const QString& StylePath,
+	QJsonObject& Json)
+{
+	QDir Dir(StylePath);
+	auto JsonFiles = Dir.entryInfoList({"*.json"}, QDir::Files);
+	if (JsonFiles.count() < 1)
+	{
+		setError(CStyleProcessor::StyleJsonError, "Stylesheet folder does "
+			"not contain a style json file");
+		return false;
+	}
+
+	if (JsonFiles.count() > 1)
+	{
+		setError(CStyleProcessor::StyleJsonError, "Stylesheet folder "
+			"contains multiple theme json files");
+		return false;
+	}
+
+	QFile StyleJsonFile(JsonFiles[0].absoluteFilePath());
+	StyleJsonFile.open(QIODevice::ReadOnly);
+
+	auto JsonData = StyleJsonFile.readAll();
+	QJsonParseError ParseError;
+	auto JsonDocument = QJsonDocument::fromJson(JsonData, &ParseError);
+	if (JsonDocument.isNull())
+	{
+		setError(CStyleProcessor::StyleJsonError, "Loading style json file "
+			"caused error: " + ParseError.errorString());
+		return false;
+	}
+
+	Json = JsonDocument.object();
+	return true;
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::parseStyleJsonFile(StyleLoadContext& Context)
+{
+	if (!readStyleJsonFile(Context.StylePath, Context.JsonStyleParam))
+	{
+		return false;
+	}
+
+	const auto& json = Context.JsonStyleParam;
+	for (auto itc = json.constBegin(); itc != json.constEnd(); ++itc)
+	{
+		if (StyleJsonKeys.indexOf(itc.key()) < 0)
+		{
+			qWarning() << "Unknown key" << itc.key() << "in style json file";
+		}
+	}
+
+	Context.JsonResources = json.value(styleJsonKey(ResourcesKey)).toObject();
+	Context.StyleName = json.value(styleJsonKey(StyleNameKey)).toString();
+	if (Context.StyleName.isEmpty())
+	{
+		setError(CStyleProcessor::StyleJsonError, "No key \"name\" found "
+			"in style json file");
+		return false;
+	}
+
+	QMap<QString, QString> Variables;
+	auto jvariables = json.value(styleJsonKey(VariablesKey)).toObject();
+	for (const auto& key : jvariables.keys())
+	{
+		Variables.insert(key, jvariables.value(key).toString());
+	}
+
+	Context.StyleVariables = Variables;
+	Context.IconFile = json.value(styleJsonKey(StyleIconKey)).toString();
+
+	return true;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::addStyleLoadStages(CStylePipeline& Pipeline,
+	StyleLoadContext& Context)
+{
+	Pipeline.addStage("themes", [&Context]()
+	{
+		Context.Themes = listThemes(Context.StylePath);
+		return true;
+	});
+	Pipeline.addStage("json", [this, &Context](){return parseStyleJsonFile(Context);});
+	Pipeline.addStage("resource_index", [&Context]()
+	{
+		Context.ResourceEntries = indexResources(Context.StylePath);
+		return true;
+	});
+	Pipeline.addStage("template", [this, &Context](){return loadTemplate(Context);}, {"json"});
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::applyStyleJson(const StyleLoadContext& Context)
+{
+	JsonStyleParam = Context.JsonStyleParam;
+	JsonResources = Context.JsonResources;
+	StyleName = Context.StyleName;
+	IconFile = Context.IconFile;
+	StyleVariables = Context.StyleVariables;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::applyStyleFiles(const StyleLoadContext& Context)
+{
+	Themes = Context.Themes;
+	ResourceEntries = Context.ResourceEntries;
+	Template = Context.Template;
+	TemplateFilePath = Context.TemplateFilePath;
+	TemplateModified = Context.TemplateModified;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::finishStyleOpen(const StyleLoadContext& Context)
+{
+	// A stale open may finish while a newer one is still queued
+	StyleOpensRunning--;
+	if (!Context.Generation.isStale())
+	{
+		clearScopes();
+		CurrentStyle = Context.Style;
+		applyStyleJson(Context);
+		applyStyleFiles(Context);
+		recordMetrics("openStyle", Context.StageResults, Context.ElapsedNs);
+		if (Context.Success)
+		{
+			CurrentTheme = Context.Theme;
+			ThemeColors = Context.ThemeColors;
+			ThemeVariables = Context.ThemeVariables;
+		}
+		_this->onCurrentStyleLoaded();
+		QDir::addSearchPath("icon", _this->currentStyleOutputPath());
+		emit _this->currentStyleChanged(CurrentStyle);
+		if (Context.Success)
+		{
+			emit _this->currentThemeChanged(CurrentTheme);
+			applyGeneration(Context.Generation, "openStyle/generate");
+			_this->onStylesheetUpdateFinished(Context.Generation.ApplyRequested);
+		}
+		_this->emitStylesheetChangedIfModified();
+	}
+
+	if (AsyncUpdatePending && !AsyncUpdateRunning && !StyleOpensRunning)
+	{
+		startAsyncUpdate(PendingApplyRequested);
+	}
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::replaceColor(QByteArray& Content,
+	const QString& TemplateColor, const QString& ThemeColor) const
+{
+	Content.replace(TemplateColor.toLatin1(), ThemeColor.toLatin1());
+}
+
+
+//============================================================================
+QFileInfoList StyleProcessorPrivate::indexResources(const QString& StylePath)
+{
+	QDir ResourceDir(StylePath + "/resources");
+	return ResourceDir.entryInfoList({"*.svg"}, QDir::Files);
+}
+
+
+//============================================================================
+QStringList StyleProcessorPrivate::listThemes(const QString& StylePath)
+{
+	QDir Dir(StylePath + "/themes");
+	auto Themes = Dir.entryList({"*.xml"}, QDir::Files);
+	for (auto& Theme : Themes)
+	{
+		Theme.replace(".xml", "");
+	}
+	return Themes;
+}
+
+
+//============================================================================
+GenerationContext StyleProcessorPrivate::createGenerationContext()
+{
+	GenerationContext Context;
+	Context.Epoch = Epoch.fetchAndAddOrdered(1) + 1;
+	Context.CurrentEpoch = &Epoch;
+	Context.Cache = &Cache;
+	Context.ThemeVariables = ThemeVariables;
+	Context.Resources = JsonResources;
+	Context.ResourceEntries = ResourceEntries;
+	Context.OutputPath = _this->currentStyleOutputPath();
+	Context.Template = Template;
+	Context.TemplateFilePath = TemplateFilePath;
+	Context.TemplateModified = TemplateModified;
+	Context.CacheStylesheet = !LeanMode;
+	Context.ResourceProcessing = _this->resourceProcessor();
+	return Context;
+}
+
+
+//============================================================================
+GenerationContext StyleProcessorPrivate::createScopeContext(const QString& Scope,
+	const QMap<QString, QString>& ThemeVariables)
+{
+	GenerationContext Context;
+	// Each scope generation starts a new scope epoch, so a generation is
+	// stale as soon as a scope is regenerated or removed
+	Context.Epoch = ScopeEpoch.fetchAndAddOrdered(1) + 1;
+	Context.CurrentEpoch = &ScopeEpoch;
+	Context.Cache = &Cache;
+	Context.ThemeVariables = ThemeVariables;
+	Context.Resources = JsonResources;
+	Context.ResourceEntries = ResourceEntries;
+	Context.OutputPath = _this->scopeOutputPath(Scope);
+	Context.Template = Template;
+	Context.TemplateFilePath = TemplateFilePath;
+	Context.TemplateModified = TemplateModified;
+	Context.ResourceProcessing = _this->resourceProcessor();
+	return Context;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::addResourceStages(CStylePipeline& Pipeline,
+	const QString& Prefix, GenerationContext& Context)
+{
+	const auto& jresources = Context.Resources;
+	if (jresources.isEmpty())
+	{
+		Pipeline.addStage(Prefix, [this]()
+		{
+			setError(CStyleProcessor::StyleJsonError, "Key resources "
+				"missing in style json file");
+			return false;
+		});
+		return;
+	}
+
+	// Process all resource generation variants
+	for (auto itc = jresources.constBegin(); itc != jresources.constEnd(); ++itc)
+	{
+		auto SubDir = itc.key();
+		auto Param = itc.value().toObject();
+		Pipeline.addStage(Prefix + ":" + SubDir, [this, SubDir, Param, &Context]()
+		{
+			if (Param.isEmpty())
+			{
+				setError(CStyleProcessor::StyleJsonError, "Key resources "
+					"missing in style json file");
+				return false;
+			}
+			return generateResourcesFor(SubDir, Param, Context);
+		});
+	}
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::addGenerationStages(CStylePipeline& Pipeline,
+	GenerationContext& Context)
+{
+	addResourceStages(Pipeline, "resources", Context);
+	Pipeline.addStage("render", [this, &Context](){return renderStylesheet(Context);});
+	Pipeline.addStage("export", [this, &Context]()
+	{
+		if (Context.TemplateFilePath.isEmpty() || Context.isStale())
+		{
+			return true;
+		}
+		storeStylesheet(Context.Stylesheet, QFileInfo(Context.TemplateFilePath).baseName()
+			+ ".css", Context.OutputPath);
+		return true;
+	}, {"render"});
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::runGeneration(CStylePipeline& Pipeline,
+	GenerationContext& Context)
+{
+	Pipeline.setCancellationCheck([&Context](){return Context.isStale();});
+	Context.Success = Pipeline.run();
+	Context.Cancelled = Context.isStale();
+	Context.StageResults = Pipeline.results();
+	Context.ElapsedNs = Pipeline.elapsedNs();
+	return Context.Success;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::applyGeneration(const GenerationContext& Context,
+	const QString& Prefix)
+{
+	recordMetrics(Prefix, Context.StageResults, Context.ElapsedNs);
+	if (Context.Stylesheet.isNull() && !Context.TemplateFilePath.isEmpty())
+	{
+		return;
+	}
+
+	StylesheetVariables = Context.ThemeVariables;
+	StylesheetTemplate = Context.Template;
+	StylesheetImageSuffix = Context.ResourceProcessing.StylesheetImageSuffix;
+	StylesheetHash = stringHash(Context.Stylesheet);
+	Stylesheet = LeanMode ? QString() : Context.Stylesheet;
+	if (Context.TemplateModified != TemplateModified)
+	{
+		Template = Context.Template;
+		TemplateModified = Context.TemplateModified;
+	}
+	releaseRetainedData();
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::releaseRetainedData()
+{
+	if (!LeanMode)
+	{
+		return;
+	}
+
+	Stylesheet = QString();
+	// The CSS template file name is only required by loadTemplate() and the
+	// resources are kept in JsonResources
+	JsonStyleParam = QJsonObject();
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::recordMetrics(const QString& Prefix,
+	const QVector<CStylePipeline::StageResult>& Results, qint64 ElapsedNs)
+{
+	QMap<QString, qint64> StageNs;
+	for (const auto& Result : Results)
+	{
+		if (Result.Executed)
+		{
+			StageNs.insert(Result.Name, Result.ElapsedNs);
+		}
+	}
+	_this->recordOperationMetrics(Prefix, ElapsedNs, StageNs);
+}
+
+
+//============================================================================
+bool StyleProcessorPrivate::generateResourcesFor(const QString& SubDir,
+	const QJsonObject& JsonObject, const GenerationContext& Context)
+{
+	const QString OutputDir = Context.OutputPath + "/" + SubDir;
+	if (!QDir().mkpath(OutputDir))
+	{
+		setError(CStyleProcessor::ResourceGeneratorError, "Error "
+			"creating resource output folder: " + OutputDir);
+		return false;
+	}
+
+	// Fill the color replace list with the values read from style json file
+	QVector<QStringPair> ColorReplaceList;
+	for (auto it = JsonObject.constBegin(); it != JsonObject.constEnd(); ++it)
+	{
+		auto TemplateColor = it.key();
+		auto ThemeColor = it.value().toString();
+		// If the color starts with an hashtag, then we have a real color value
+		// If it does not start with # then it is a theme variable
+		if (!ThemeColor.startsWith('#'))
+		{
+			ThemeColor = Context.ThemeVariables.value(ThemeColor);
+		}
+		ColorReplaceList.append({TemplateColor, ThemeColor});
+	}
+
+	QCryptographicHash ReplaceHash(QCryptographicHash::Sha1);
+	for (const auto& Replace : ColorReplaceList)
+	{
+		ReplaceHash.addData(stringHash(Replace.first + ':' + Replace.second));
+	}
+	auto ReplaceKey = QString::fromLatin1(ReplaceHash.result().toHex());
+
+	// Now loop through all resources svg files and replace the colors
+	for (const auto& Entry : Context.ResourceEntries)
+	{
+		// Files of a stale generation are not written anymore, because they
+		// would be overwritten by the newer generation anyway
+		if (Context.isStale())
+		{
+			return false;
+		}
+
+		auto Key = Entry.absoluteFilePath() + ":"
+			+ QString::number(Entry.lastModified().toMSecsSinceEpoch()) + ":" + ReplaceKey;
+		QByteArray Content;
+		if (!Context.Cache->find(CStyleCache::ResourceArtifact, Key, Content))
+		{
+			QFile SvgFile(Entry.absoluteFilePath());
+			SvgFile.open(QIODevice::ReadOnly);
+			Content = SvgFile.readAll();
+			SvgFile.close();
+
+			for (const auto& Replace : ColorReplaceList)
+			{
+				replaceColor(Content, Replace.first, Replace.second);
+			}
+			Context.Cache->insert(CStyleCache::ResourceArtifact, Key, Content);
+		}
+
+		QString OutputFilename = OutputDir + "/" + Entry.fileName();
+		QFile OutputFile(OutputFilename);
+		OutputFile.open(QIODevice::WriteOnly);
+		OutputFile.write(Content);
+		OutputFile.close();
+		const auto& Process = Context.ResourceProcessing.Process;
+		if (Process && !Process(OutputFilename, Content))
+		{
+			setError(CStyleProcessor::ResourceGeneratorError, "Error "
+				"processing resource " + OutputFilename);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//============================================================================
+CStyleProcessor::CStyleProcessor(QObject* parent) :
+	QObject(parent),
+	d(new StyleProcessorPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CStyleProcessor::~CStyleProcessor()
+{
+	// Cancel a running asynchronous update and wait until it is finished
+	d->Epoch.fetchAndAddOrdered(1);
+	d->AsyncPool.waitForDone();
+	delete d;
+}
+
+
+//============================================================================
+void CStyleProcessor::setStylesDirPath(const QString& DirPath)
+{
+	d->StylesDir = DirPath;
+	QDir Dir(d->StylesDir);
+	d->Styles = Dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+}
+
+
+//============================================================================
+QString CStyleProcessor::stylesDirPath() const
+{
+	return d->StylesDir;
+}
+
+
+//============================================================================
+bool CStyleProcessor::setCurrentStyle(const QString& Style)
+{
+	d->clearError();
+	d->Epoch.fetchAndAddOrdered(1);
+	d->clearScopes();
+	d->CurrentStyle = Style;
+
+	StyleLoadContext Context;
+	Context.Style = Style;
+	Context.StylePath = currentStylePath();
+
+	// The font registration and the palette in onCurrentStyleLoaded() are the
+	// only stages that need to run in the GUI thread
+	CStylePipeline Pipeline;
+	d->addStyleLoadStages(Pipeline, Context);
+	Pipeline.addStage("loaded", [this, &Context]()
+	{
+		d->applyStyleJson(Context);
+		onCurrentStyleLoaded();
+		return true;
+	}, {"json"}, CStylePipeline::CallerThread);
+	auto Result = Pipeline.run();
+	d->applyStyleFiles(Context);
+	d->recordMetrics("setCurrentStyle", Pipeline.results(), Pipeline.elapsedNs());
+
+	d->releaseRetainedData();
+	QDir::addSearchPath("icon", currentStyleOutputPath());
+	emit currentStyleChanged(d->CurrentStyle);
+	emitStylesheetChangedIfModified();
+	return Result;
+}
+
+
+//============================================================================
+QString CStyleProcessor::currentStyle() const
+{
+	return d->CurrentStyle;
+}
+
+
+//============================================================================
+QString CStyleProcessor::currentStylePath() const
+{
+	return d->StylesDir + "/" + d->CurrentStyle;
+}
+
+
+//============================================================================
+QString CStyleProcessor::outputDirPath() const
+{
+	return d->OutputDir;
+}
+
+
+//============================================================================
+void CStyleProcessor::setOutputDirPath(const QString& Path)
+{
+	d->OutputDir = Path;
+}
+
+
+//============================================================================
+QString CStyleProcessor::currentStyleOutputPath() const
+{
+	return outputDirPath() + "/" + d->CurrentStyle;
+}
+
+
+//============================================================================
+QString CStyleProcessor::themeVariableValue(const QString& VariableId) const
+{
+	return d->ThemeVariables.value(VariableId, QString());
+}
+
+
+//============================================================================
+void CStyleProcessor::setThemeVariableValue(const QString& VariableId, const QString& Value)
+{
+	d->Epoch.fetchAndAddOrdered(1);
+	d->ThemeVariables.insert(VariableId, Value);
+	auto it = d->ThemeColors.find(VariableId);
+	if (it != d->ThemeColors.end())
+	{
+		it.value() = Value;
+	}
+}
+
+
+//============================================================================
+void CStyleProcessor::setVariableOverride(const QString& VariableId, const QString& Value)
+{
+	if (d->CurrentTheme.isEmpty())
+	{
+		return;
+	}
+
+	d->VariableOverrides[d->overridesKey(d->CurrentStyle, d->CurrentTheme)]
+		.insert(VariableId, Value);
+	setThemeVariableValue(VariableId, Value);
+	d->saveVariableOverrides();
+}
+
+
+//============================================================================
+void CStyleProcessor::removeVariableOverride(const QString& VariableId)
+{
+	auto it = d->VariableOverrides.find(d->overridesKey(d->CurrentStyle, d->CurrentTheme));
+	if (it == d->VariableOverrides.end() || !it.value().remove(VariableId))
+	{
+		return;
+	}
+
+	if (it.value().isEmpty())
+	{
+		d->VariableOverrides.erase(it);
+	}
+	d->restoreThemeValues({VariableId});
+	d->saveVariableOverrides();
+}
+
+
+//============================================================================
+void CStyleProcessor::clearVariableOverrides()
+{
+	auto Overrides = d->VariableOverrides.take(d->overridesKey(d->CurrentStyle,
+		d->CurrentTheme));
+	if (Overrides.isEmpty())
+	{
+		return;
+	}
+
+	d->restoreThemeValues(Overrides.keys());
+	d->saveVariableOverrides();
+}
+
+
+//============================================================================
+QMap<QString, QString> CStyleProcessor::variableOverrides() const
+{
+	return d->VariableOverrides.value(d->overridesKey(d->CurrentStyle, d->CurrentTheme));
+}
+
+
+//============================================================================
+bool CStyleProcessor::setVariableOverridesFilePath(const QString& FilePath)
+{
+	d->VariableOverridesFilePath = FilePath;
+	d->VariableOverrides.clear();
+	QFile OverridesFile(FilePath);
+	if (!FilePath.isEmpty() && OverridesFile.exists())
+	{
+		if (!OverridesFile.open(QIODevice::ReadOnly))
+		{
+			return false;
+		}
+
+		auto jOverrides = QJsonDocument::fromJson(OverridesFile.readAll()).object();
+		for (auto itc = jOverrides.constBegin(); itc != jOverrides.constEnd(); ++itc)
+		{
+			auto jVariables = itc.value().toObject();
+			auto& Variables = d->VariableOverrides[itc.key()];
+			for (auto itv = jVariables.constBegin(); itv != jVariables.constEnd(); ++itv)
+			{
+				Variables.insert(itv.key(), itv.value().toString());
+			}
+		}
+	}
+
+	// The loaded theme gets the overrides of the new file
+	if (!d->CurrentTheme.isEmpty())
+	{
+		d->reloadCurrentTheme();
+	}
+	return true;
+}
+
+
+//============================================================================
+QString CStyleProcessor::variableOverridesFilePath() const
+{
+	return d->VariableOverridesFilePath;
+}
+
+
+//============================================================================
+bool CStyleProcessor::setCurrentTheme(const QString& Theme)
+{
+	d->clearError();
+	if (d->StyleName.isEmpty())
+	{
+		return false;
+	}
+
+	if (!d->parseThemeFile(Theme + ".xml"))
+	{
+		return false;
+	}
+
+	d->Epoch.fetchAndAddOrdered(1);
+	d->CurrentTheme = Theme;
+	d->applyVariableOverrides(d->VariableOverrides.value(d->overridesKey(
+		d->CurrentStyle, Theme)), d->ThemeColors, d->ThemeVariables);
+	emit currentThemeChanged(d->CurrentTheme);
+	return true;
+}
+
+
+//============================================================================
+bool CStyleProcessor::updateStylesheet()
+{
+	if (!runUpdatePipeline(true))
+	{
+		return false;
+	}
+
+	emitStylesheetChangedIfModified();
+	return true;
+}
+
+
+//============================================================================
+bool CStyleProcessor::runUpdatePipeline(bool CallUpdateHook)
+{
+	d->clearError();
+	auto Context = d->createGenerationContext();
+	auto Serial = ++d->UpdateSerial;
+	bool Result;
+	{
+		// Waits for a stale asynchronous generation that may still write files
+		QMutexLocker Lock(&d->GenerationMutex);
+		CStylePipeline Pipeline;
+		d->addGenerationStages(Pipeline, Context);
+		Result = d->runGeneration(Pipeline, Context);
+	}
+
+	if (Context.Cancelled)
+	{
+		d->setError(CancelledError, "The generation has been cancelled by a "
+			"newer generation");
+	}
+
+	// The update hook runs without the generation lock. It updates the
+	// application palette and the delivered palette change events may call
+	// updateStylesheet() or generateResources() again.
+	if (CallUpdateHook)
+	{
+		QElapsedTimer Timer;
+		Timer.start();
+		onStylesheetUpdate();
+		CStylePipeline::StageResult GuiResult;
+		GuiResult.Name = "gui";
+		GuiResult.Executed = true;
+		GuiResult.Success = true;
+		GuiResult.ElapsedNs = Timer.nsecsElapsed();
+		Context.StageResults.append(GuiResult);
+		Context.ElapsedNs += GuiResult.ElapsedNs;
+	}
+
+	// A nested update from the hook already applied a newer generation
+	if (Serial != d->UpdateSerial)
+	{
+		d->recordMetrics("updateStylesheet", Context.StageResults, Context.ElapsedNs);
+	}
+	else
+	{
+		d->applyGeneration(Context, "updateStylesheet");
+	}
+	return Result;
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::requestAsyncUpdate(bool ApplyRequested)
+{
+	if (StyleOpensRunning)
+	{
+		// The update starts as soon as the new style has been loaded
+		AsyncUpdatePending = true;
+		PendingApplyRequested = PendingApplyRequested || ApplyRequested;
+		return;
+	}
+
+	if (AsyncUpdateRunning)
+	{
+		// Cancel the running generation - the update is restarted with the
+		// current theme data as soon as the stale generation finished
+		Epoch.fetchAndAddOrdered(1);
+		AsyncUpdatePending = true;
+		PendingApplyRequested = PendingApplyRequested || ApplyRequested;
+		return;
+	}
+
+	startAsyncUpdate(ApplyRequested);
+}
+
+
+//============================================================================
+void CStyleProcessor::requestStylesheetUpdate()
+{
+	d->clearError();
+	d->requestAsyncUpdate(false);
+}
+
+
+//============================================================================
+void CStyleProcessor::requestStylesheetUpdate(bool ApplyRequested)
+{
+	d->clearError();
+	d->requestAsyncUpdate(ApplyRequested);
+}
+
+
+//============================================================================
+void CStyleProcessor::openStyle(const QString& Style, const QString& Theme)
+{
+	openStyle(Style, Theme, false);
+}
+
+
+//============================================================================
+void CStyleProcessor::openStyle(const QString& Style, const QString& Theme,
+	bool ApplyRequested)
+{
+	d->clearError();
+	d->StyleOpensRunning++;
+	d->AsyncUpdatePending = false;
+	d->PendingApplyRequested = false;
+	auto Context = QSharedPointer<StyleLoadContext>::create();
+	Context->Style = Style;
+	Context->StylePath = d->StylesDir + "/" + Style;
+	Context->Theme = Theme;
+	Context->VariableOverrides = d->VariableOverrides;
+	// Starts a new epoch - all running generations and style open
+	// operations become stale
+	Context->Generation = d->createGenerationContext();
+	Context->Generation.OutputPath = outputDirPath() + "/" + Style;
+	Context->Generation.ApplyRequested = ApplyRequested;
+	d->AsyncPool.start(new CStyleOpenRunnable(d, Context));
+}
+
+
+//============================================================================
+bool CStyleProcessor::isStyleOpenRunning() const
+{
+	return d->StyleOpensRunning > 0;
+}
+
+
+//============================================================================
+bool CStyleProcessor::generateScopedStyle(const QString& Scope, const QString& Theme)
+{
+	d->clearError();
+	static const QRegularExpression ScopeRegex("^[A-Za-z0-9]+$");
+	if (!ScopeRegex.match(Scope).hasMatch())
+	{
+		d->setError(ResourceGeneratorError, "Invalid scope name " + Scope);
+		return false;
+	}
+
+	if (d->StyleName.isEmpty())
+	{
+		return false;
+	}
+
+	ScopeData Data;
+	Data.Theme = Theme;
+	QMap<QString, QString> ThemeVariables;
+	if (!d->readThemeFile(path(ThemesLocation) + "/" + Theme + ".xml",
+		d->StyleVariables, Data.ThemeColors, ThemeVariables))
+	{
+		return false;
+	}
+	d->applyVariableOverrides(d->VariableOverrides.value(d->overridesKey(
+		d->CurrentStyle, Theme)), Data.ThemeColors, ThemeVariables);
+
+	if (d->ResourceEntries.isEmpty())
+	{
+		d->ResourceEntries = d->indexResources(currentStylePath());
+	}
+
+	auto Context = d->createScopeContext(Scope, ThemeVariables);
+	CStylePipeline Pipeline;
+	d->addResourceStages(Pipeline, "resources", Context);
+	Pipeline.addStage("render", [this, &Context](){return d->renderStylesheet(Context);});
+	d->runGeneration(Pipeline, Context);
+	d->recordMetrics("generateScopedStyle", Context.StageResults, Context.ElapsedNs);
+	if (!Context.Success)
+	{
+		return false;
+	}
+
+	// The icons of the scope are loaded from the scope output folder
+	static const QRegularExpression IconUrlRegex("url\\(\\s*([\"']?)icon:");
+	auto Prefix = scopeIconPrefix(Scope);
+	Data.Stylesheet = Context.Stylesheet;
+	Data.Stylesheet.replace(IconUrlRegex, "url(\\1" + Prefix + ":");
+	QDir::setSearchPaths(Prefix, {Context.OutputPath});
+	d->Scopes.insert(Scope, Data);
+	return true;
+}
+
+
+//============================================================================
+QString CStyleProcessor::scopedStylesheet(const QString& Scope) const
+{
+	return d->Scopes.value(Scope).Stylesheet;
+}
+
+
+//============================================================================
+QString CStyleProcessor::scopedTheme(const QString& Scope) const
+{
+	return d->Scopes.value(Scope).Theme;
+}
+
+
+//============================================================================
+QMap<QString, QString> CStyleProcessor::scopedThemeColorVariables(const QString& Scope) const
+{
+	return d->Scopes.value(Scope).ThemeColors;
+}
+
+
+//============================================================================
+QString CStyleProcessor::scopeIconPrefix(const QString& Scope)
+{
+	return "icon" + Scope;
+}
+
+
+//============================================================================
+QString CStyleProcessor::scopeOutputPath(const QString& Scope) const
+{
+	return currentStyleOutputPath() + "/scopes/" + Scope;
+}
+
+
+//============================================================================
+QStringList CStyleProcessor::scopes() const
+{
+	return d->Scopes.keys();
+}
+
+
+//============================================================================
+void CStyleProcessor::removeScope(const QString& Scope)
+{
+	if (d->Scopes.remove(Scope))
+	{
+		d->ScopeEpoch.fetchAndAddOrdered(1);
+		QDir::setSearchPaths(scopeIconPrefix(Scope), {});
+		QDir(scopeOutputPath(Scope)).removeRecursively();
+	}
+}
+
+
+//============================================================================
+bool CStyleProcessor::isStylesheetUpdateRunning() const
+{
+	return d->AsyncUpdateRunning;
+}
+
+
+//============================================================================
+void CStyleProcessor::onStylesheetUpdateFinished(bool ApplyRequested)
+{
+	Q_UNUSED(ApplyRequested);
+	onStylesheetUpdate();
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::startAsyncUpdate(bool ApplyRequested)
+{
+	AsyncUpdateRunning = true;
+	AsyncUpdatePending = false;
+	PendingApplyRequested = false;
+	auto Context = QSharedPointer<GenerationContext>::create(createGenerationContext());
+	Context->ApplyRequested = ApplyRequested;
+	AsyncPool.start(new CGenerationRunnable(this, Context));
+}
+
+
+//============================================================================
+void StyleProcessorPrivate::finishAsyncUpdate(const GenerationContext& Context)
+{
+	AsyncUpdateRunning = false;
+	// A pending update request is started by finishStyleOpen() as soon as
+	// the new style has been loaded
+	if (StyleOpensRunning)
+	{
+		return;
+	}
+
+	// The restarted update keeps the apply request of the cancelled one
+	if (AsyncUpdatePending)
+	{
+		startAsyncUpdate(PendingApplyRequested || Context.ApplyRequested);
+		return;
+	}
+
+	// The theme or a variable changed without a new update request - the
+	// outputs of the stale generation and its apply request are discarded
+	if (Context.Cancelled || Context.isStale())
+	{
+		return;
+	}
+
+	applyGeneration(Context, "requestStylesheetUpdate");
+	_this->onStylesheetUpdateFinished(Context.ApplyRequested);
+	_this->emitStylesheetChangedIfModified();
+}
+
+
+//============================================================================
+bool CStyleProcessor::processStyleTemplate()
+{
+	return generateResources();
+}
+
+
+//============================================================================
+QString CStyleProcessor::currentTheme() const
+{
+	return d->CurrentTheme;
+}
+
+
+//============================================================================
+QString CStyleProcessor::styleSheet() const
+{
+	// The variables are rendered with the template of their generation -
+	// before the first generation, there is no stylesheet
+	if (d->LeanMode)
+	{
+		return d->StylesheetTemplate.isEmpty() ? QString()
+			: renderTemplate(d->StylesheetTemplate, d->StylesheetVariables,
+				d->StylesheetImageSuffix);
+	}
+	return d->Stylesheet;
+}
+
+
+//============================================================================
+QString CStyleProcessor::styleIconPath() const
+{
+	if (d->IconFile.isEmpty())
+	{
+		return QString();
+	}
+
+	return currentStylePath() + "/" + d->IconFile;
+}
+
+
+//============================================================================
+const QStringList& CStyleProcessor::styles() const
+{
+	return d->Styles;
+}
+
+
+//============================================================================
+const QStringList& CStyleProcessor::themes() const
+{
+	return d->Themes;
+}
+
+
+//============================================================================
+QString CStyleProcessor::processStylesheetTemplate(const QString& Template,
+	const QString& OutputFile)
+{
+	CStyleTemplate CompiledTemplate;
+	CompiledTemplate.compile(Template);
+	auto Stylesheet = CompiledTemplate.render(d->ThemeVariables);
+	if (!OutputFile.isEmpty())
+	{
+		d->storeStylesheet(Stylesheet, OutputFile, currentStyleOutputPath());
+	}
+	return Stylesheet;
+}
+
+
+//============================================================================
+const QMap<QString, QString>& CStyleProcessor::themeColorVariables() const
+{
+	return d->ThemeColors;
+}
+
+
+//============================================================================
+CStyleProcessor::eError CStyleProcessor::error() const
+{
+	return d->Error;
+}
+
+
+//============================================================================
+QString CStyleProcessor::errorString() const
+{
+	return d->ErrorString;
+}
+
+
+//============================================================================
+QString CStyleProcessor::path(eLocation Location) const
+{
+	switch (Location)
+	{
+	case ThemesLocation: return currentStylePath() + "/themes";
+	case ResourceTemplatesLocation: return currentStylePath() + "/resources";
+	case FontsLocation: return currentStylePath() + "/fonts";
+	}
+
+	return QString();
+}
+
+
+//============================================================================
+bool CStyleProcessor::generateResources()
+{
+	if (d->ResourceEntries.isEmpty())
+	{
+		d->ResourceEntries = d->indexResources(currentStylePath());
+	}
+
+	auto Context = d->createGenerationContext();
+	QMutexLocker Lock(&d->GenerationMutex);
+	CStylePipeline Pipeline;
+	d->addResourceStages(Pipeline, "resources", Context);
+	auto Result = d->runGeneration(Pipeline, Context);
+	if (Context.Cancelled)
+	{
+		d->setError(CancelledError, "The generation has been cancelled by a "
+			"newer generation");
+	}
+	d->recordMetrics("generateResources", Context.StageResults, Context.ElapsedNs);
+	return Result;
+}
+
+
+//============================================================================
+const QJsonObject& CStyleProcessor::styleParameters() const
+{
+	if (d->JsonStyleParam.isEmpty() && !d->StyleName.isEmpty())
+	{
+		d->readStyleJsonFile(currentStylePath(), d->JsonStyleParam);
+	}
+	return d->JsonStyleParam;
+}
+
+
+//============================================================================
+bool CStyleProcessor::lastUpdateChangedStyle() const
+{
+	return d->LastUpdateChangedStyle;
+}
+
+
+//============================================================================
+void CStyleProcessor::recordOperationMetrics(const QString& Operation,
+	qint64 ElapsedNs, const QMap<QString, qint64>& StageNs)
+{
+	// Operations of an outer operation are recorded as its stages
+	if (d->OuterOperations > 0)
+	{
+		d->NestedOperationNs[Operation] += ElapsedNs;
+		return;
+	}
+
+	static const double NsPerMs = 1000000.0;
+	d->StageMetrics[Operation].add(ElapsedNs);
+	QVariantMap Stages;
+	for (auto itc = StageNs.constBegin(); itc != StageNs.constEnd(); ++itc)
+	{
+		d->StageMetrics[Operation + "/" + itc.key()].add(itc.value());
+		Stages.insert(itc.key(), itc.value() / NsPerMs);
+	}
+	emit operationFinished(Operation, ElapsedNs / NsPerMs, Stages);
+}
+
+
+//============================================================================
+void CStyleProcessor::beginOperation()
+{
+	d->OuterOperations++;
+}
+
+
+//============================================================================
+void CStyleProcessor::endOperation(const QString& Operation, qint64 ElapsedNs)
+{
+	if (--d->OuterOperations > 0)
+	{
+		return;
+	}
+
+	QMap<QString, qint64> StageNs;
+	StageNs.swap(d->NestedOperationNs);
+	recordOperationMetrics(Operation, ElapsedNs, StageNs);
+}
+
+
+//============================================================================
+QJsonObject CStyleProcessor::metrics() const
+{
+	static const double NsPerMs = 1000000.0;
+	QJsonObject jStages;
+	for (auto itc = d->StageMetrics.constBegin(); itc != d->StageMetrics.constEnd(); ++itc)
+	{
+		const auto& Metric = itc.value();
+		QJsonObject jStage;
+		jStage.insert("count", double(Metric.Count));
+		jStage.insert("last_ms", Metric.LastNs / NsPerMs);
+		jStage.insert("avg_ms", Metric.Count ? Metric.TotalNs / NsPerMs / Metric.Count : 0.0);
+		jStage.insert("max_ms", Metric.MaxNs / NsPerMs);
+		jStages.insert(itc.key(), jStage);
+	}
+
+	QJsonObject jMetrics;
+	jMetrics.insert("stages", jStages);
+	jMetrics.insert("cache", d->Cache.stats());
+	return jMetrics;
+}
+
+
+//============================================================================
+void CStyleProcessor::resetMetrics()
+{
+	d->StageMetrics.clear();
+	d->Cache.resetStats();
+}
+
+
+//============================================================================
+void CStyleProcessor::setLeanMode(bool Enable)
+{
+	if (d->LeanMode == Enable)
+	{
+		return;
+	}
+
+	if (!Enable && !d->StylesheetTemplate.isEmpty())
+	{
+		d->Stylesheet = renderTemplate(d->StylesheetTemplate, d->StylesheetVariables,
+			d->StylesheetImageSuffix);
+	}
+	d->LeanMode = Enable;
+	d->releaseRetainedData();
+}
+
+
+//============================================================================
+bool CStyleProcessor::isLeanMode() const
+{
+	return d->LeanMode;
+}
+
+
+//============================================================================
+QJsonObject CStyleProcessor::memoryFootprint() const
+{
+	QJsonObject jItems;
+	jItems.insert("style_variables", double(mapBytes(d->StyleVariables)));
+	jItems.insert("theme_colors", double(mapBytes(d->ThemeColors)));
+	jItems.insert("theme_variables", double(mapBytes(d->ThemeVariables)));
+	// The variables of the last generation usually share their data with the
+	// theme variables
+	jItems.insert("stylesheet_variables", double(d->StylesheetVariables.isSharedWith(
+		d->ThemeVariables) ? 0 : mapBytes(d->StylesheetVariables)));
+	jItems.insert("style_parameters_estimate", double(jsonBytes(d->JsonStyleParam)
+		+ jsonBytes(d->JsonResources)));
+	jItems.insert("template", double(d->Template.memoryUsage()));
+	jItems.insert("stylesheet", double(stringBytes(d->Stylesheet)));
+	jItems.insert("resource_index", double(fileInfoListBytes(d->ResourceEntries)));
+	jItems.insert("style_lists", double(stringListBytes(d->Styles)
+		+ stringListBytes(d->Themes)));
+	qint64 ContainerBytes = mapNodeBytesEstimate(d->StyleVariables)
+		+ mapNodeBytesEstimate(d->ThemeColors) + mapNodeBytesEstimate(d->ThemeVariables)
+		+ d->ResourceEntries.size() * qint64(sizeof(void*) * 8);
+	if (!d->StylesheetVariables.isSharedWith(d->ThemeVariables))
+	{
+		ContainerBytes += mapNodeBytesEstimate(d->StylesheetVariables);
+	}
+	jItems.insert("container_overhead_estimate", double(ContainerBytes));
+	jItems.insert("artifact_cache", double(d->Cache.size()));
+	return jItems;
+}
+
+
+//============================================================================
+QString CStyleProcessor::memoryReport() const
+{
+	auto jItems = memoryFootprint();
+	QVector<QPair<qint64, QString>> Items;
+	qint64 Total = 0;
+	for (auto itc = jItems.constBegin(); itc != jItems.constEnd(); ++itc)
+	{
+		auto Bytes = qint64(itc.value().toDouble());
+		Items.append({Bytes, itc.key()});
+		Total += Bytes;
+	}
+	std::sort(Items.begin(), Items.end(), [](const QPair<qint64, QString>& a,
+		const QPair<qint64, QString>& b) {return a.first > b.first;});
+
+	QString Report = QString("Memory footprint of style %1 / %2:\n")
+		.arg(d->CurrentStyle, d->CurrentTheme);
+	for (const auto& Item : Items)
+	{
+		Report += QString("  %1 %2 bytes\n").arg(Item.second, -24).arg(Item.first, 10);
+	}
+	Report += QString("  %1 %2 bytes\n").arg("total", -24).arg(Total, 10);
+	return Report;
+}
+
+
+//============================================================================
+ResourceProcessor CStyleProcessor::resourceProcessor() const
+{
+	return ResourceProcessor();
+}
+
+
+//============================================================================
+CStyleCache& CStyleProcessor::artifactCache() const
+{
+	return d->Cache;
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleProcessor.cpp
@@ -0,0 +1,625 @@
+#ifndef StyleProcessorH
+#define StyleProcessorH
+//============================================================================
+/// \file   StyleProcessor.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStyleProcessor class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QPair>
+#include <QMap>
+#include <QObject>
+#include <QVariantMap>
+
+#include <functional>
+
+class QJsonObject;
+
+namespace acss
+{
+struct StyleProcessorPrivate;
+class CStyleCache;
+using QStringPair = QPair<QString, QString>;
+
+/**
+ * Processing of the generated SVG resources in the worker threads of the
+ * generation pipeline. See CStyleProcessor::resourceProcessor().
+ */
+struct ResourceProcessor
+{
+	/**
+	 * Called for each written SVG resource with its file path and its
+	 * content. The function runs in worker threads and needs to be thread
+	 * safe. Returns false on error.
+	 */
+	std::function<bool(const QString& FilePath, const QByteArray& Content)> Process;
+
+	/**
+	 * If not empty, the ".svg" suffix of the icon: URLs in the stylesheet is
+	 * replaced by this suffix (i.e. "png")
+	 */
+	QString StylesheetImageSuffix;
+};
+
+/**
+ * Headless core of the style manager.
+ * This class parses the style JSON file and the theme files, processes the
+ * stylesheet template and generates the SVG resources. It only depends on
+ * QtCore, so it can be used in command line tools, on servers and in worker
+ * threads. Use the CStyleManager class from the widgets library, if you
+ * would like to apply the style to a QApplication.
+ */
+class CStyleProcessor : public QObject
+{
+	Q_OBJECT
+private:
+	StyleProcessorPrivate* d; ///< private data (pimpl)
+	friend struct StyleProcessorPrivate;
+
+public:
+	enum eError
+	{
+		NoError,
+		CssTemplateError,
+		CssExportError,
+		ThemeXmlError,
+		StyleJsonError,
+		ResourceGeneratorError,
+		CancelledError ///< a newer generation epoch cancelled the operation
+	};
+
+	enum eLocation
+	{
+		ThemesLocation,
+		ResourceTemplatesLocation,
+		FontsLocation
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CStyleProcessor(QObject* parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CStyleProcessor();
+
+	/**
+	 * Set the directory path that contains all styles
+	 */
+	void setStylesDirPath(const QString& DirPath);
+
+	/**
+	 * Returns the set styles dir
+	 */
+	QString stylesDirPath() const;
+
+	/**
+	 * Returns the current style
+	 */
+	QString currentStyle() const;
+
+	/**
+	 * Returns the absolute path of the current style.
+	 * If your styles stylesDirPath() is C:/styles and your current style is
+	 * qt_material then this function returns C:/styles/qt_material
+	 */
+	QString currentStylePath() const;
+
+	/**
+	 * Returns the list of available styles in the given styles directory
+	 */
+	const QStringList& styles() const;
+
+	/**
+	 * Returns a list of all themes for the current style.
+	 * If no style has been set, this function returns an empty list
+	 */
+	const QStringList& themes() const;
+
+	/**
+	 * Returns a list of all theme variables for colors
+	 */
+	const QMap<QString, QString>& themeColorVariables() const;
+
+	/**
+	 * Returns the absolute dir path for the given location
+	 */
+	QString path(eLocation Location) const;
+
+	/**
+	 * Returns the absolute output dir path where the generated styles will
+	 * get stored.
+	 * \see setOutputDirPath()
+	 */
+	QString outputDirPath() const;
+
+	/**
+	 * Sets the output directory path where the generated theme will be stored
+	 */
+	void setOutputDirPath(const QString& Path);
+
+	/**
+	 * Returns the output path for the current style.
+	 * The output path is the outputDirPath() + the style name.
+	 * If your output path is C:/temp/styles and your style is qt_material
+	 * then this functions returns C:/temp/styles/qt_material
+	 */
+	QString currentStyleOutputPath() const;
+
+	/**
+	 * Returns the value for the given theme variable.
+	 * For example themeVariable("primaryColor") may return "#ac2300".
+	 * Returns an empty string, if the given theme variable does not exist.
+	 */
+	QString themeVariableValue(const QString& VariableId) const;
+
+	/**
+	 * You can use this function to add or overwrite a theme variable.
+	 * You may use this function to add application specific colors that are not
+	 * defined in the current style.
+	 * If you changed a theme variable or a number of theme variables then you
+	 * should call updateStylesheet() to request a reprocessing of the style
+	 * template and to update the stylesheet.
+	 * The value is lost if the theme is changed. Use setVariableOverride()
+	 * for values that should persist.
+	 */
+	void setThemeVariableValue(const QString& VariableId, const QString& Value);
+
+	/**
+	 * Sets a persistent override of the given theme variable for the current
+	 * style and theme. The overrides of a theme are applied each time the
+	 * theme file is loaded, so they survive theme switches. If an overrides
+	 * file has been set via setVariableOverridesFilePath(), they also survive
+	 * an application restart. Because the overrides are applied before the
+	 * generation, the artifact cache finds the artifacts that have been
+	 * generated with the same overrides before.
+	 * Call updateStylesheet() to apply the change.
+	 */
+	void setVariableOverride(const QString& VariableId, const QString& Value);
+
+	/**
+	 * Removes the override of the given theme variable for the current style
+	 * and theme and restores the value from the theme file. The values of
+	 * all other variables are kept.
+	 * Call updateStylesheet() to apply the change.
+	 */
+	void removeVariableOverride(const QString& VariableId);
+
+	/**
+	 * Removes all overrides of the current style and theme and restores the
+	 * values of the overridden variables from the theme file.
+	 * Call updateStylesheet() to apply the change.
+	 */
+	void clearVariableOverrides();
+
+	/**
+	 * Returns the overrides of the current style and theme
+	 */
+	QMap<QString, QString> variableOverrides() const;
+
+	/**
+	 * Sets the file that stores the variable overrides of all styles and
+	 * themes and loads the overrides from this file. If a theme is loaded,
+	 * it is reloaded with the overrides from the new file, so values set via
+	 * setThemeVariableValue() are lost - set this file before the style is
+	 * loaded. Each change of an override is written to the file. With an
+	 * empty path, the overrides are only kept in memory.
+	 * Returns false, if the file exists but can not be read.
+	 */
+	bool setVariableOverridesFilePath(const QString& FilePath);
+
+	/**
+	 * Returns the file path of the variable overrides file
+	 */
+	QString variableOverridesFilePath() const;
+
+	/**
+	 * Returns the current set theme
+	 */
+	QString currentTheme() const;
+
+	/**
+	 * Returns the processed style stylesheet.
+	 * If the style or the theme of a style changed, you can read the new
+	 * stylesheet from this function.
+	 * In lean mode, the stylesheet is rendered from the compiled template on
+	 * each call.
+	 */
+	QString styleSheet() const;
+
+	/**
+	 * This function replaces the style variables in the given template with
+	 * the value of the registered style variables.
+	 * You can use this function if you have split your stylesheet into
+	 * several parts or if you use plugins that provide additional stylesheets
+	 * to get the processed stylesheed if the theme changed.
+	 * Returns the final stylesheet or an empty string in case of an error.
+	 * If the OutputFile parameter is given, the generated stylesheet file
+	 * will be stored into the currentStyleOutputPath() folder with the given
+	 * OutputFile name.
+	 */
+	QString processStylesheetTemplate(const QString& Template, const QString& OutputFile = QString());
+
+	/**
+	 * Returns the absolute file path of the style icon or an empty string if
+	 * the style does not provide an icon
+	 */
+	QString styleIconPath() const;
+
+	/**
+	 * Returns the error state of the object.
+	 */
+	eError error() const;
+
+	/**
+	 * Returns a string describing the last error that occured
+	 */
+	QString errorString() const;
+
+	/**
+	 * Read access to the Json object with all stlye parameters.
+	 * In lean mode, the style JSON file is parsed again on demand.
+	 */
+	const QJsonObject& styleParameters() const;
+
+	/**
+	 * Returns true, if the last call to setCurrentStyle() or updateStylesheet()
+	 * changed the style, the theme, the generated stylesheet or the theme
+	 * colors.
+	 * If style and theme are the ones of the last stylesheetChanged() signal
+	 * and the rendered stylesheet and the theme colors are identical (i.e. if
+	 * the current theme has been reselected or a variable has been set to
+	 * its current value), then the signal is not emitted and this function
+	 * returns false. After a style or theme switch, the signal is always
+	 * emitted.
+	 */
+	bool lastUpdateChangedStyle() const;
+
+	/**
+	 * Returns the execution time metrics of the style operations.
+	 * The object "stages" contains one entry per operation (i.e.
+	 * "setCurrentStyle", "updateStylesheet", "requestStylesheetUpdate" or
+	 * "openStyle") and one entry per pipeline stage of an operation (i.e.
+	 * "updateStylesheet/render") with the number
+	 * of executions and the last, average and maximum time in milliseconds.
+	 * The object "cache" contains the statistics of the artifactCache().
+	 */
+	QJsonObject metrics() const;
+
+	/**
+	 * Clears all collected metrics
+	 */
+	void resetMetrics();
+
+	/**
+	 * Returns the cache for the generated stylesheets and resources.
+	 * Use this function to configure the memory budget and the spill
+	 * directory of the cache. Derived classes may store additional artifacts
+	 * like rasterized icons in the cache.
+	 */
+	CStyleCache& artifactCache() const;
+
+	/**
+	 * Returns the number of heap bytes held by this object.
+	 * The object contains one entry per data item (i.e. "theme_variables",
+	 * "template", "stylesheet" or "artifact_cache") with the number of bytes.
+	 * The items are measured from the string and pixmap sizes. Items that
+	 * can only be estimated, because Qt does not expose the size (i.e. the
+	 * nodes of the containers or the parsed JSON data), end with "_estimate".
+	 * Derived classes add their own data items.
+	 */
+	virtual QJsonObject memoryFootprint() const;
+
+	/**
+	 * Returns a text report of the memoryFootprint() sorted by size.
+	 * You can write the report to the debug output, i.e. to check the memory
+	 * budget or to detect growing data after repeated theme switches.
+	 */
+	QString memoryReport() const;
+
+	/**
+	 * Enables or disables the lean mode for memory constrained devices.
+	 * In lean mode, the processor does not keep a copy of the generated
+	 * stylesheet and of the parsed style parameters. It only keeps the
+	 * compiled template and the theme variables of the last generation.
+	 * styleSheet() renders the stylesheet on demand and styleParameters()
+	 * parses the style JSON file on demand - the parsed parameters are
+	 * released again on the next stylesheet update. Before the first
+	 * generation, styleSheet() returns an empty string.
+	 * The stylesheet is not stored in the artifactCache() in lean mode.
+	 */
+	void setLeanMode(bool Enable);
+
+	/**
+	 * Returns true, if the lean mode is enabled
+	 */
+	bool isLeanMode() const;
+
+	/**
+	 * Returns true, while an update requested via requestStylesheetUpdate()
+	 * is running
+	 */
+	bool isStylesheetUpdateRunning() const;
+
+	/**
+	 * Returns true, while a style load started via openStyle() is running
+	 */
+	bool isStyleOpenRunning() const;
+
+	/**
+	 * Generates the SVG resources and the stylesheet of the given theme for
+	 * the given scope without changing the current theme. Use scopes to
+	 * style single windows or widget subtrees with a different theme than
+	 * the application.
+	 * The theme file is parsed for each scope, but the style JSON file and
+	 * the compiled template of the current style are shared and the
+	 * generated artifacts are taken from and stored in the artifactCache().
+	 * The resources are written to scopeOutputPath() and the "icon:" URLs of
+	 * the scope stylesheet are replaced by the scope prefix
+	 * scopeIconPrefix() that is registered via QDir::setSearchPaths(). So
+	 * the name of a scope may contain only letters and numbers.
+	 * All scopes are discarded and their resource folders are deleted if the
+	 * current style changes.
+	 */
+	bool generateScopedStyle(const QString& Scope, const QString& Theme);
+
+	/**
+	 * Returns the stylesheet of the given scope
+	 */
+	QString scopedStylesheet(const QString& Scope) const;
+
+	/**
+	 * Returns the theme of the given scope
+	 */
+	QString scopedTheme(const QString& Scope) const;
+
+	/**
+	 * Returns the theme color variables of the given scope
+	 */
+	QMap<QString, QString> scopedThemeColorVariables(const QString& Scope) const;
+
+	/**
+	 * Returns the URL prefix of the icons of the given scope (i.e.
+	 * "iconpreview" for the scope "preview")
+	 */
+	static QString scopeIconPrefix(const QString& Scope);
+
+	/**
+	 * Returns the folder the resources of the given scope are written to
+	 */
+	QString scopeOutputPath(const QString& Scope) const;
+
+	/**
+	 * Returns the names of all scopes
+	 */
+	QStringList scopes() const;
+
+	/**
+	 * Removes the given scope and deletes its resource folder
+	 */
+	void removeScope(const QString& Scope);
+
+
+public slots:
+	/**
+	 * Sets the theme to use.
+	 * Use the theme name without the file extension. That means, if your
+	 * theme file id dark_cyan.xml then set the theme to `dark_cyan'
+	 * Returns true on success and false on error.
+	 * Changing the theme does not trigger a stylesheet update. So after
+	 * changing the theme, you can add or overwrite theme variables
+	 * via setThemeVariableValue()
+	 * To trigger processing of the style template, you need to call
+	 * explicitely updateStylesheet().
+	 */
+	bool setCurrentTheme(const QString& Theme);
+
+	/**
+	 * Set the current style.
+	 * The theme listing, the parsing of the style JSON file, the indexing of
+	 * the SVG resources and the loading of the stylesheet template run
+	 * concurrently. Only onCurrentStyleLoaded() is called in the calling
+	 * thread.
+	 */
+	bool setCurrentStyle(const QString& Style);
+
+	/**
+	 * Call this function if you would like to reprocess the style template.
+	 * Call this function, if you have changed the theme or some theme variables
+	 * via setThemeVariable() to request an update of the stylesheet.
+	 * The function generates the theme SVG resources and the stylesheet
+	 * (if the style has a template file) concurrently in worker threads and
+	 * calls onStylesheetUpdate() in the calling thread.
+	 * If you have split your stylesheet into several pieces or if your would
+	 * like to separate the update of the resources and the generation of
+	 * the stylehseets, then you should not use this function. Instead, call
+	 * processStyleTemplate() to generate the SVG resources and then use
+	 * processStylesheetTemplate() to generate the style sheets.
+	 */
+	bool updateStylesheet();
+
+	/**
+	 * Asynchronous variant of updateStylesheet().
+	 * The resources and the stylesheet are generated in a worker thread from
+	 * a snapshot of the current theme data and the function returns
+	 * immediately. When the generation finished, onStylesheetUpdateFinished()
+	 * is called and stylesheetChanged() is emitted in the thread of this
+	 * object.
+	 * Each theme change, each variable change and each update request
+	 * starts a new generation epoch. A running generation of an older epoch
+	 * is cancelled, it does not write any further files and its results are
+	 * discarded. So if the user quickly scrolls through a list of themes,
+	 * only the theme the user finally selected is generated completely.
+	 */
+	void requestStylesheetUpdate();
+
+	/**
+	 * Asynchronous variant of setCurrentStyle() followed by setCurrentTheme()
+	 * and updateStylesheet() for a fast cold start.
+	 * The theme listing, the parsing of the style JSON file, the indexing of
+	 * the SVG resources, the loading of the stylesheet template and the
+	 * parsing of the theme file run concurrently in worker threads, followed
+	 * by the generation of the resources and the stylesheet. The function
+	 * returns immediately. When the style is ready, the data is taken over
+	 * in the thread of this object, onCurrentStyleLoaded() and
+	 * onStylesheetUpdateFinished() are called and currentStyleChanged(),
+	 * currentThemeChanged() and stylesheetChanged() are emitted.
+	 * If Theme is empty, the first theme of the style is used.
+	 * Calling setCurrentStyle(), setCurrentTheme() or openStyle() while the
+	 * operation is running cancels it.
+	 */
+	void openStyle(const QString& Style, const QString& Theme = QString());
+
+	/**
+	 * Call this function, if you would like to update the SVG files.
+	 * The function calls generateResources(). Derived classes like the
+	 * CStyleManager extend this function to update the application palette.
+	 * The function will not update or create any stylesheet. After calling this
+	 * function, you can use the processStylesheetTemplate() function to
+	 * manually generate the style sheets from stylesheet template files.
+	 */
+	virtual bool processStyleTemplate();
+
+	/**
+	 * Generate the required icons for this theme.
+	 * You can call this function, if you changed some theme settings or theme
+	 * variables and if you would like to recreate the svg resources of this
+	 * style.If you call updateStylesheet(), then this function will be
+	 * called automatically
+	 */
+	bool generateResources();
+
+signals:
+	/**
+	 * This signal is emitted if the selected style changed
+	 */
+	void currentStyleChanged(const QString& Style);
+
+	/**
+	 * This signal is emitted, if the selected theme in a style changed
+	 */
+	void currentThemeChanged(const QString& Theme);
+
+	/**
+	 * This signal is emitted if the stylesheet changed.
+	 * The stylecheed changes if the style changes, the theme changes or if a
+	 * style variable changed an the user requested a styleheet update.
+	 * The signal is always emitted after a style or theme switch. A
+	 * re-rendering with the same style and theme does not emit the signal,
+	 * if the rendered stylesheet and the theme colors did not change since
+	 * the last emission.
+	 */
+	void stylesheetChanged();
+
+	/**
+	 * This signal is emitted in the calling thread after each timed style
+	 * operation (i.e. "setCurrentStyle", "updateStylesheet" or
+	 * "applyToApplication") with its duration and the durations of its stages
+	 * in milliseconds. The same values are collected in metrics().
+	 */
+	void operationFinished(const QString& Operation, double ElapsedMs,
+		const QVariantMap& StageMs);
+
+protected:
+	/**
+	 * This function is called by setCurrentStyle() after the style JSON file
+	 * has been parsed and before the change signals are emitted.
+	 * Derived classes can use it to load additional style data like fonts.
+	 * The default implementation does nothing.
+	 */
+	virtual void onCurrentStyleLoaded() {}
+
+	/**
+	 * This function is called by updateStylesheet() in the calling thread,
+	 * after the resources and the stylesheet have been generated. The
+	 * generation lock is not held, so it is safe to start another update
+	 * from here. The CStyleManager updates the application palette here.
+	 * The default implementation does nothing.
+	 */
+	virtual void onStylesheetUpdate() {}
+
+	/**
+	 * This function is called in the thread of this object, if a generation
+	 * requested via requestStylesheetUpdate() or openStyle() finished and
+	 * has not been cancelled, before stylesheetChanged() is emitted.
+	 * ApplyRequested is the flag that has been passed to the protected
+	 * request function. It belongs to the request - it is dropped with a
+	 * cancelled or failed request and never passed on to a later one.
+	 * The default implementation calls onStylesheetUpdate().
+	 */
+	virtual void onStylesheetUpdateFinished(bool ApplyRequested);
+
+	/**
+	 * Variant of requestStylesheetUpdate() that passes ApplyRequested to
+	 * onStylesheetUpdateFinished(). If the request restarts a running
+	 * generation, the restarted generation keeps the flag.
+	 */
+	void requestStylesheetUpdate(bool ApplyRequested);
+
+	/**
+	 * Variant of openStyle() that passes ApplyRequested to
+	 * onStylesheetUpdateFinished()
+	 */
+	void openStyle(const QString& Style, const QString& Theme, bool ApplyRequested);
+
+	/**
+	 * Returns the resource processor for a new generation. The function is
+	 * called in the thread of this object when a generation starts, so the
+	 * returned processor should capture a copy of all data it needs.
+	 * The CStyleManager rasterizes the resources for the stylesheet here.
+	 * The default implementation returns an empty processor.
+	 */
+	virtual ResourceProcessor resourceProcessor() const;
+
+	/**
+	 * Generates the SVG resources and the stylesheet. The resource variants,
+	 * the stylesheet rendering and the stylesheet export run as independent
+	 * stages of a CStylePipeline. If CallUpdateHook is true, then
+	 * onStylesheetUpdate() is called in the calling thread afterwards.
+	 * Returns false on error.
+	 */
+	bool runUpdatePipeline(bool CallUpdateHook);
+
+	/**
+	 * Emits the stylesheetChanged() signal, if the style, the theme, the
+	 * stylesheet or the theme colors differ from the ones of the last
+	 * emission.
+	 * Returns true, if the signal has been emitted
+	 */
+	bool emitStylesheetChangedIfModified();
+
+	/**
+	 * Adds the execution time of an operation and its stages to the metrics()
+	 * and emits operationFinished(). Derived classes use this function to
+	 * record the time of their own operations.
+	 */
+	void recordOperationMetrics(const QString& Operation, qint64 ElapsedNs,
+		const QMap<QString, qint64>& StageNs = QMap<QString, qint64>());
+
+	/**
+	 * Starts an operation that consists of other recorded operations. Until
+	 * the matching endOperation() call, the nested operations are not
+	 * recorded on their own but become the stages of the outer operation,
+	 * so that their time is not counted twice.
+	 */
+	void beginOperation();
+
+	/**
+	 * Finishes an operation started with beginOperation() and records it
+	 * with the nested operations as stages
+	 */
+	void endOperation(const QString& Operation, qint64 ElapsedNs);
+}; // class CStyleProcessor
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleProcessorH
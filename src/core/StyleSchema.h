@@ -0,0 +1,228 @@
+#ifndef StyleSchemaH
+#define StyleSchemaH
+//============================================================================
+/// \file   StyleSchema.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Compile time lookup tables for the style JSON schema
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+
+namespace acss
+{
+/**
+ * Entry of a CSchemaTable - a name and the value it is mapped to
+ */
+template <class T>
+struct SchemaEntry
+{
+	const char* Name;
+	T Value;
+};
+
+
+/**
+ * Final mixing step of the schemaHash(). The low bits of a plain FNV-1a
+ * hash only depend on the low bits of the seed and the characters, so the
+ * high bits are folded in before the bucket is selected.
+ */
+constexpr quint32 schemaMix(quint32 Hash)
+{
+	Hash = (Hash ^ (Hash >> 16)) * 0x45d9f3bu;
+	return Hash ^ (Hash >> 16);
+}
+
+
+/**
+ * FNV-1a hash of the given ASCII name for the CSchemaTable
+ */
+constexpr quint32 schemaHash(const char* Name, quint32 Seed)
+{
+	quint32 Hash = 2166136261u ^ Seed;
+	for (; *Name; ++Name)
+	{
+		Hash = (Hash ^ quint8(*Name)) * 16777619u;
+	}
+	return schemaMix(Hash);
+}
+
+
+/**
+ * Perfect hash table that maps names to values.
+ * The table is built at compile time via makeSchemaTable(). The builder
+ * searches a hash seed that maps all names to distinct buckets, so a lookup
+ * is one hash calculation and one string compare without any allocation.
+ * Duplicate names can never be placed and leave the table invalid, so a
+ * static_assert on isValid() catches them at build time.
+ */
+template <class T, int Count, int Buckets>
+struct CSchemaTable
+{
+	SchemaEntry<T> Entries[Count];
+	int Slots[Buckets];
+	quint32 Seed;
+	bool Valid;
+
+	/**
+	 * Returns true, if a collision free seed has been found
+	 */
+	constexpr bool isValid() const {return Valid;}
+
+	/**
+	 * Returns the index of the entry with the given name or -1.
+	 * This function is meant for static_assert() checks of the table.
+	 */
+	constexpr int find(const char* Name) const
+	{
+		int Slot = Slots[schemaHash(Name, Seed) % Buckets];
+		if (Slot < 0)
+		{
+			return -1;
+		}
+		const char* a = Entries[Slot].Name;
+		const char* b = Name;
+		for (; *a && *a == *b; ++a, ++b) {}
+		return (*a == *b) ? Slot : -1;
+	}
+
+	/**
+	 * Returns the index of the entry with the given name or -1
+	 */
+	int indexOf(const QString& Name) const
+	{
+		quint32 Hash = 2166136261u ^ Seed;
+		for (auto Char : Name)
+		{
+			if (Char.unicode() > 0x7f)
+			{
+				return -1;
+			}
+			Hash = (Hash ^ quint8(Char.unicode())) * 16777619u;
+		}
+		int Slot = Slots[schemaMix(Hash) % Buckets];
+		if (Slot < 0 || Name != QLatin1String(Entries[Slot].Name))
+		{
+			return -1;
+		}
+		return Slot;
+	}
+
+	/**
+	 * Returns the value for the given name or the given default value
+	 */
+	T value(const QString& Name, T DefaultValue) const
+	{
+		int Index = indexOf(Name);
+		return (Index < 0) ? DefaultValue : Entries[Index].Value;
+	}
+
+	/**
+	 * Returns the name of the first entry with the given value or nullptr
+	 */
+	const char* name(T Value) const
+	{
+		for (const auto& Entry : Entries)
+		{
+			if (Entry.Value == Value)
+			{
+				return Entry.Name;
+			}
+		}
+		return nullptr;
+	}
+};
+
+
+/**
+ * Builds the perfect hash table for the given entries at compile time.
+ * Use a bucket count of about twice the number of entries.
+ */
+template <int Buckets, class T, int Count>
+constexpr CSchemaTable<T, Count, Buckets> makeSchemaTable(const SchemaEntry<T> (&Entries)[Count])
+{
+	CSchemaTable<T, Count, Buckets> Table{};
+	for (int i = 0; i < Count; ++i)
+	{
+		Table.Entries[i] = Entries[i];
+	}
+
+	for (quint32 Seed = 0; Seed < 4096; ++Seed)
+	{
+		for (int i = 0; i < Buckets; ++i)
+		{
+			Table.Slots[i] = -1;
+		}
+
+		bool Collision = false;
+		for (int i = 0; i < Count && !Collision; ++i)
+		{
+			auto Bucket = schemaHash(Entries[i].Name, Seed) % Buckets;
+			Collision = Table.Slots[Bucket] >= 0;
+			Table.Slots[Bucket] = i;
+		}
+
+		if (!Collision)
+		{
+			Table.Seed = Seed;
+			Table.Valid = true;
+			return Table;
+		}
+	}
+
+	Table.Valid = false;
+	return Table;
+}
+
+
+/**
+ * Keys of the style JSON file
+ */
+enum eStyleJsonKey
+{
+	StyleNameKey,
+	StyleIconKey,
+	CssTemplateKey,
+	ResourcesKey,
+	VariablesKey,
+	PaletteKey,
+	UnknownStyleJsonKey
+};
+
+
+/**
+ * Keys of the style JSON file
+ */
+constexpr SchemaEntry<eStyleJsonKey> StyleJsonKeyEntries[] = {
+	{"name", StyleNameKey},
+	{"icon", StyleIconKey},
+	{"css_template", CssTemplateKey},
+	{"resources", ResourcesKey},
+	{"variables", VariablesKey},
+	{"palette", PaletteKey}
+};
+
+
+/**
+ * Perfect hash table of the style JSON keys
+ */
+constexpr auto StyleJsonKeys = makeSchemaTable<16>(StyleJsonKeyEntries);
+static_assert(StyleJsonKeys.isValid(), "Duplicate or colliding style JSON keys");
+static_assert(StyleJsonKeys.find("css_template") == CssTemplateKey
+	&& StyleJsonKeys.find("palette") == PaletteKey
+	&& StyleJsonKeys.find("css_templates") < 0, "Invalid style JSON key table");
+
+
+/**
+ * Returns the name of the given style JSON key for QJsonObject::value()
+ */
+inline QLatin1String styleJsonKey(eStyleJsonKey Key)
+{
+	return QLatin1String(StyleJsonKeyEntries[Key].Name);
+}
+} // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleSchemaH
@@ -0,0 +1,27 @@
+#ifndef StyleSimdH
+#define StyleSimdH
+//============================================================================
+/// \file   StyleSimd.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Detection of the SIMD instruction sets used by the core library
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+// SSE2 is part of all x86-64 CPUs and is used unconditionally. AVX2 code is
+// compiled with function specific target attributes and needs to be
+// selected at runtime via __builtin_cpu_supports("avx2"). Without SSE2, the
+// scalar fallbacks are used.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ACSS_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ACSS_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+//-----------------------------------------------------------------------------
+#endif // StyleSimdH
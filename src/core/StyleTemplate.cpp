@@ -0,0 +1,466 @@
+//============================================================================
+/// \file   StyleTemplate.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStyleTemplate class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleTemplate.h>
+#include <ColorBatch.h>
+#include <StyleSimd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <QHash>
+#include <QRegularExpression>
+#include <QtAlgorithms>
+
+namespace acss
+{
+using FindPairFunction = const char* (*)(const char*, const char*, char);
+
+/**
+ * Returns the position of the first two consecutive Delimiter characters in
+ * the range from Begin to End or End, if the range does not contain them
+ */
+static const char* findPairScalar(const char* Begin, const char* End, char Delimiter)
+{
+	for (auto p = Begin; p + 1 < End; ++p)
+	{
+		if (p[0] == Delimiter && p[1] == Delimiter)
+		{
+			return p;
+		}
+	}
+	return End;
+}
+
+
+#ifdef ACSS_SSE2
+/**
+ * SSE2 variant of findPairScalar(). Each block compares 16 positions and
+ * the 16 following positions, so a match in both masks is a delimiter pair.
+ */
+static const char* findPairSse2(const char* Begin, const char* End, char Delimiter)
+{
+	const __m128i Needle = _mm_set1_epi8(Delimiter);
+	auto p = Begin;
+	for (; p + 17 <= End; p += 16)
+	{
+		auto First = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), Needle);
+		auto Second = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1)), Needle);
+		auto Mask = quint32(_mm_movemask_epi8(_mm_and_si128(First, Second)));
+		if (Mask)
+		{
+			return p + qCountTrailingZeroBits(Mask);
+		}
+	}
+	return findPairScalar(p, End, Delimiter);
+}
+#endif
+
+
+#ifdef ACSS_AVX2
+/**
+ * AVX2 variant of findPairSse2() with 32 positions per block
+ */
+__attribute__((target("avx2")))
+static const char* findPairAvx2(const char* Begin, const char* End, char Delimiter)
+{
+	const __m256i Needle = _mm256_set1_epi8(Delimiter);
+	auto p = Begin;
+	for (; p + 33 <= End; p += 32)
+	{
+		auto First = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), Needle);
+		auto Second = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1)), Needle);
+		auto Mask = quint32(_mm256_movemask_epi8(_mm256_and_si256(First, Second)));
+		if (Mask)
+		{
+			return p + qCountTrailingZeroBits(Mask);
+		}
+	}
+	return findPairSse2(p, End, Delimiter);
+}
+#endif
+
+
+/**
+ * Selects the fastest delimiter search the CPU supports
+ */
+static FindPairFunction selectFindPair()
+{
+#ifdef ACSS_AVX2
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return findPairAvx2;
+	}
+#endif
+#ifdef ACSS_SSE2
+	return findPairSse2;
+#else
+	return findPairScalar;
+#endif
+}
+
+
+/**
+ * Returns the position of the first delimiter pair (i.e. "{{") in the given
+ * range or End
+ */
+static const char* findPair(const char* Begin, const char* End, char Delimiter)
+{
+	static const FindPairFunction Function = selectFindPair();
+	return Function(Begin, End, Delimiter);
+}
+
+
+//============================================================================
+void CStyleTemplate::compile(const QString& Template)
+{
+	compile(Template.toUtf8());
+}
+
+
+//============================================================================
+void CStyleTemplate::compile(const QByteArray& Template)
+{
+	static const QString OpacityStr("opacity(");
+
+	Literals.clear();
+	Placeholders.clear();
+	VariableIds.clear();
+	LiteralsSize = 0;
+	QHash<QString, int> VariableIndexes;
+
+	const char* Begin = Template.constData();
+	const char* End = Begin + Template.size();
+	const char* LiteralStart = Begin;
+	const char* p = Begin;
+	while ((p = findPair(p, End, '{')) != End)
+	{
+		// Placeholders never span multiple lines
+		const char* Close = findPair(p + 2, End, '}');
+		if (Close == End)
+		{
+			break;
+		}
+		auto LineEnd = static_cast<const char*>(std::memchr(p + 2, '\n', Close - p - 2));
+		if (LineEnd)
+		{
+			p = LineEnd;
+			continue;
+		}
+
+		auto Content = QString::fromUtf8(p + 2, int(Close - p - 2));
+		Placeholder Entry;
+		QString VariableId = Content;
+		if (Content.endsWith(')'))
+		{
+			auto Values = Content.split('|');
+			VariableId = Values[0];
+			auto OpacityValue = Values.value(1);
+			Entry.Opacity = OpacityValue.mid(OpacityStr.size(),
+				OpacityValue.size() - OpacityStr.size() - 1).toFloat();
+		}
+
+		auto it = VariableIndexes.find(VariableId);
+		if (it == VariableIndexes.end())
+		{
+			it = VariableIndexes.insert(VariableId, VariableIds.size());
+			VariableIds.append(VariableId);
+		}
+		Entry.VariableIndex = it.value();
+
+		Literals.append(QString::fromUtf8(LiteralStart, int(p - LiteralStart)));
+		LiteralsSize += Literals.last().size();
+		Placeholders.append(Entry);
+		p = LiteralStart = Close + 2;
+	}
+
+	Literals.append(QString::fromUtf8(LiteralStart, int(End - LiteralStart)));
+	LiteralsSize += Literals.last().size();
+}
+
+
+//============================================================================
+QString CStyleTemplate::render(const QStringList& Values) const
+{
+	// The opacity variants of all placeholders are computed in one batch
+	CColorBatch OpacityColors;
+	QVector<float> Opacities;
+	QVector<bool> ValidColors;
+	for (const auto& Entry : Placeholders)
+	{
+		if (Entry.Opacity >= 0)
+		{
+			ValidColors.append(OpacityColors.append(Values[Entry.VariableIndex]));
+			Opacities.append(Entry.Opacity);
+		}
+	}
+	OpacityColors.multiplyAlpha(Opacities);
+
+	QString Result;
+	// Colors are at most 9 characters long - so this is a good estimation
+	Result.reserve(LiteralsSize + Placeholders.size() * 9);
+	int OpacityIndex = 0;
+	for (int i = 0; i < Placeholders.size(); ++i)
+	{
+		Result.append(Literals[i]);
+		const auto& Entry = Placeholders[i];
+		const auto& Value = Values[Entry.VariableIndex];
+		if (Entry.Opacity < 0)
+		{
+			Result.append(Value);
+		}
+		else
+		{
+			Result.append(ValidColors[OpacityIndex] ? OpacityColors.name(OpacityIndex, true)
+				: Value);
+			OpacityIndex++;
+		}
+	}
+
+	if (!Literals.isEmpty())
+	{
+		Result.append(Literals.last());
+	}
+	return Result;
+}
+
+
+//============================================================================
+QString CStyleTemplate::render(const QMap<QString, QString>& Variables) const
+{
+	return render(resolve(Variables));
+}
+
+
+//============================================================================
+QStringList CStyleTemplate::resolve(const QMap<QString, QString>& Variables) const
+{
+	QStringList Values;
+	Values.reserve(VariableIds.size());
+	for (const auto& VariableId : VariableIds)
+	{
+		Values.append(Variables.value(VariableId));
+	}
+	return Values;
+}
+
+
+/**
+ * Returns the given text as C++ UTF-16 string literal. Long texts are split
+ * into several adjacent literals with at most 100 characters each.
+ */
+static QString cppStringLiteral(const QString& Text)
+{
+	QString Result("u\"");
+	int LineLength = 0;
+	for (int i = 0; i < Text.size(); ++i)
+	{
+		if (LineLength >= 100)
+		{
+			Result += "\"\n\tu\"";
+			LineLength = 0;
+		}
+
+		auto Char = Text[i];
+		auto Code = Char.unicode();
+		// Surrogates must not be written as universal character names
+		if (Char.isHighSurrogate() && i + 1 < Text.size() && Text[i + 1].isLowSurrogate())
+		{
+			auto CodePoint = QChar::surrogateToUcs4(Char, Text[++i]);
+			Result += QString("\\U%1").arg(CodePoint, 8, 16, QChar('0'));
+			LineLength++;
+			continue;
+		}
+
+		switch (Code)
+		{
+		case '\\': Result += "\\\\"; break;
+		case '"': Result += "\\\""; break;
+		case '?': Result += "\\?"; break; // no trigraphs
+		case '\n': Result += "\\n"; break;
+		case '\r': Result += "\\r"; break;
+		case '\t': Result += "\\t"; break;
+		default:
+			if (Char.isSurrogate())
+			{
+				Result += "\\ufffd";
+			}
+			else if (Code < 0x20 || Code > 0x7e)
+			{
+				Result += QString("\\u%1").arg(Code, 4, 16, QChar('0'));
+			}
+			else
+			{
+				Result += Char;
+			}
+		}
+		LineLength++;
+	}
+	Result += '"';
+	return Result;
+}
+
+
+/**
+ * Returns the given text as C++ narrow string literal with UTF-8 encoding.
+ * Non-ASCII and control characters are written as octal escapes, because
+ * hex escapes would consume following hex digits.
+ */
+static QString cppUtf8Literal(const QString& Text)
+{
+	QString Result("\"");
+	for (auto Byte : Text.toUtf8())
+	{
+		auto Code = uchar(Byte);
+		switch (Code)
+		{
+		case '\\': Result += "\\\\"; break;
+		case '"': Result += "\\\""; break;
+		case '?': Result += "\\?"; break; // no trigraphs
+		default:
+			if (Code < 0x20 || Code > 0x7e)
+			{
+				Result += QString("\\%1").arg(Code, 3, 8, QChar('0'));
+			}
+			else
+			{
+				Result += QChar(Code);
+			}
+		}
+	}
+	Result += '"';
+	return Result;
+}
+
+
+//============================================================================
+QString CStyleTemplate::toCppSource(const QString& FunctionName,
+	const QString& SourceFileName) const
+{
+	// A line break in the file name would end the comment
+	auto Source = SourceFileName.isEmpty() ? QString("a stylesheet template")
+		: SourceFileName;
+	Source.replace(QRegularExpression("[\\r\\n]"), " ");
+	QStringList Lines;
+	Lines << "// Generated from " + Source + " - do not edit" << ""
+		<< "#include <QString>" << "#include <QStringList>" << "";
+
+	Lines << QString("constexpr int %1VariableCount = %2;").arg(FunctionName)
+		.arg(VariableIds.size());
+	QStringList Ids;
+	for (const auto& VariableId : VariableIds)
+	{
+		Ids << "\t" + cppUtf8Literal(VariableId);
+	}
+	Lines << QString("constexpr const char* %1VariableIds[%1VariableCount + 1] = {")
+		.arg(FunctionName) << Ids.join(",\n") + (Ids.isEmpty() ? "" : ",")
+		+ "\n\tnullptr\n};" << "";
+
+	for (int i = 0; i < Literals.size(); ++i)
+	{
+		if (!Literals[i].isEmpty())
+		{
+			Lines << QString("static const char16_t Literal%1[] = %2;").arg(i)
+				.arg(cppStringLiteral(Literals[i]));
+		}
+	}
+
+	// The generated source does not depend on this library, so it gets its
+	// own copy of rgbaColor() with the same results as the CColorBatch
+	bool HasOpacity = std::any_of(Placeholders.begin(), Placeholders.end(),
+		[](const Placeholder& Entry){return Entry.Opacity >= 0;});
+	if (HasOpacity)
+	{
+		Lines << "" << "static QString rgbaColor(const QString& Color, float Opacity)"
+			<< "{"
+			<< "\tbool Ok = false;"
+			<< "\tuint Value = Color.mid(1).toUInt(&Ok, 16);"
+			<< "\tint Digits = Color.size() - 1;"
+			<< "\tif (!Color.startsWith('#') || !Ok || (Digits != 3 && Digits != 6 && Digits != 8))"
+			<< "\t{" << "\t\treturn Color;" << "\t}" << ""
+			<< "\tif (Digits == 3)"
+			<< "\t{"
+			<< "\t\tValue = ((Value & 0xf00) << 8 | (Value & 0xf0) << 4 | (Value & 0xf)) * 17;"
+			<< "\t}"
+			<< "\tfloat Alpha = ((Digits == 8) ? (Value >> 24) / 255.0f : 1.0f) * Opacity;"
+			<< "\tint AlphaByte = qBound(0.0f, Alpha, 1.0f) * 255;"
+			<< "\tauto Rgb = QString(\"%1\").arg(Value & 0xffffff, 6, 16, QChar('0'));"
+			<< "\treturn (AlphaByte < 255) ? QString(\"#%1%2\").arg(AlphaByte, 2, 16, QChar('0')).arg(Rgb)"
+			<< "\t\t: \"#\" + Rgb;"
+			<< "}";
+	}
+
+	auto Append = [&Lines, this](int i)
+	{
+		if (!Literals[i].isEmpty())
+		{
+			Lines << QString("\tResult.append(reinterpret_cast<const QChar*>(Literal%1), %2);")
+				.arg(i).arg(Literals[i].size());
+		}
+	};
+
+	Lines << "" << QString("QString %1(const QStringList& Values)").arg(FunctionName)
+		<< "{" << "\tQString Result;"
+		<< QString("\tResult.reserve(%1);").arg(LiteralsSize + Placeholders.size() * 9);
+	for (int i = 0; i < Placeholders.size(); ++i)
+	{
+		Append(i);
+		const auto& Entry = Placeholders[i];
+		if (Entry.Opacity < 0)
+		{
+			Lines << QString("\tResult.append(Values[%1]);").arg(Entry.VariableIndex);
+		}
+		else
+		{
+			Lines << QString("\tResult.append(rgbaColor(Values[%1], %2f));").arg(Entry.VariableIndex)
+				.arg(double(Entry.Opacity), 0, 'g', 9);
+		}
+	}
+	if (!Literals.isEmpty())
+	{
+		Append(Literals.size() - 1);
+	}
+	Lines << "\treturn Result;" << "}" << "";
+	return Lines.join('\n');
+}
+
+
+//============================================================================
+qint64 CStyleTemplate::memoryUsage() const
+{
+	qint64 Bytes = Placeholders.capacity() * qint64(sizeof(Placeholder));
+	for (const auto& List : {&Literals, &VariableIds})
+	{
+		Bytes += List->size() * qint64(sizeof(void*) + sizeof(QArrayData));
+		for (const auto& String : *List)
+		{
+			Bytes += String.capacity() * qint64(sizeof(QChar));
+		}
+	}
+	return Bytes;
+}
+
+
+//============================================================================
+QString CStyleTemplate::rgbaColor(const QString& RgbColor, float Opacity)
+{
+	CColorBatch Batch;
+	if (!Batch.append(RgbColor))
+	{
+		return RgbColor;
+	}
+	Batch.multiplyAlpha(Opacity);
+	return Batch.name(0, true);
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleTemplate.cpp
@@ -0,0 +1,135 @@
+#ifndef StyleTemplateH
+#define StyleTemplateH
+//============================================================================
+/// \file   StyleTemplate.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStyleTemplate class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+
+namespace acss
+{
+/**
+ * Compiled stylesheet template.
+ * The template is parsed once into a list of literal text segments and
+ * placeholders. Each placeholder references a variable from the list of
+ * variableIds() and an optional opacity value - i.e. {{primaryColor}} or
+ * {{primaryColor|opacity(0.2)}}. Rendering the template for a theme then
+ * only requires the concatenation of the literals and the resolved
+ * variable values without any parsing.
+ */
+class CStyleTemplate
+{
+public:
+	struct Placeholder
+	{
+		int VariableIndex = -1; ///< index into variableIds()
+		float Opacity = -1; ///< opacity value or -1 if no opacity is given
+	};
+
+	/**
+	 * Compiles the given template.
+	 * Any previously compiled content is discarded.
+	 */
+	void compile(const QString& Template);
+
+	/**
+	 * Compiles the given UTF-8 encoded template.
+	 * The delimiters are located with SSE2 or AVX2 instructions if the CPU
+	 * supports them, so compiling a large template is mainly limited by the
+	 * memory bandwidth. Prefer this function for templates read from files
+	 * to avoid the conversion to UTF-16.
+	 */
+	void compile(const QByteArray& Template);
+
+	/**
+	 * Returns true, if no template has been compiled
+	 */
+	bool isEmpty() const {return Literals.isEmpty();}
+
+	/**
+	 * Returns the list of all variables used in the template. Each variable
+	 * is contained only once.
+	 */
+	const QStringList& variableIds() const {return VariableIds;}
+
+	/**
+	 * Returns the literal text segments. The template always consists of
+	 * literals().size() literals and literals().size() - 1 placeholders.
+	 * Placeholder i is located between literal i and literal i + 1.
+	 */
+	const QStringList& literals() const {return Literals;}
+
+	/**
+	 * Returns the list of placeholders
+	 */
+	const QVector<Placeholder>& placeholders() const {return Placeholders;}
+
+	/**
+	 * Renders the template with the given resolved variable values.
+	 * Values must contain the value for each variable in variableIds() in
+	 * the same order.
+	 */
+	QString render(const QStringList& Values) const;
+
+	/**
+	 * Renders the template with the values from the given variable map.
+	 * Unknown variables are replaced by an empty string.
+	 */
+	QString render(const QMap<QString, QString>& Variables) const;
+
+	/**
+	 * Resolves the values of all variableIds() from the given variable map
+	 */
+	QStringList resolve(const QMap<QString, QString>& Variables) const;
+
+	/**
+	 * Generates a C++ source file with a renderer for this template.
+	 * The source defines the function
+	 * \code
+	 * QString FunctionName(const QStringList& Values);
+	 * \endcode
+	 * that renders the template from the resolved variable values in the
+	 * order of variableIds() via a straight sequence of appends of the
+	 * literals with precomputed lengths. The variable ids are provided in
+	 * the constexpr table FunctionNameVariableIds with
+	 * FunctionNameVariableCount entries. So an application that ships only
+	 * one style can compile the renderer into the application and does not
+	 * need to parse or compile the template at runtime. The generated source
+	 * only depends on QtCore.
+	 */
+	QString toCppSource(const QString& FunctionName,
+		const QString& SourceFileName = QString()) const;
+
+	/**
+	 * Returns the estimated number of heap bytes of the compiled template
+	 */
+	qint64 memoryUsage() const;
+
+	/**
+	 * Creates an Rgba color from a given color and an opacity value in the
+	 * range from 0 (transparent) to 1 (opaque). The alpha value of the color
+	 * is multiplied with the opacity. Invalid colors are returned unchanged.
+	 * \see CColorBatch::multiplyAlpha()
+	 */
+	static QString rgbaColor(const QString& RgbColor, float Opacity);
+
+private:
+	QStringList Literals;
+	QVector<Placeholder> Placeholders;
+	QStringList VariableIds;
+	int LiteralsSize = 0;
+}; // class CStyleTemplate
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleTemplateH
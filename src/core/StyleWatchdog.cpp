@@ -0,0 +1,196 @@
+//============================================================================
+/// \file   StyleWatchdog.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStyleWatchdog class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleWatchdog.h>
+#include <StyleProcessor.h>
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QTimer>
+
+namespace acss
+{
+/**
+ * Private data class of CStyleWatchdog class (pimpl)
+ */
+struct StyleWatchdogPrivate
+{
+	CStyleWatchdog *_this;
+	double Threshold = 100;
+	bool LoggingEnabled = true;
+	QElapsedTimer Clock;
+	bool EpisodeOpen = false;
+	qint64 EpisodeStartNs = 0;
+	double OperationsMs = 0;
+	QVariantMap Breakdown;
+	qint64 Episodes = 0;
+	qint64 Stalls = 0;
+	double MaxStallMs = 0;
+	double TotalStallMs = 0;
+	QVariantMap MaxStallBreakdown;
+
+	/**
+	 * Private data constructor
+	 */
+	StyleWatchdogPrivate(CStyleWatchdog *_public);
+};// struct StyleWatchdogPrivate
+
+
+//============================================================================
+StyleWatchdogPrivate::StyleWatchdogPrivate(
+    CStyleWatchdog *_public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+CStyleWatchdog::CStyleWatchdog(CStyleProcessor* Processor, QObject* parent) :
+	QObject(parent),
+	d(new StyleWatchdogPrivate(this))
+{
+	d->Clock.start();
+	connect(Processor, &CStyleProcessor::operationFinished, this,
+		&CStyleWatchdog::onOperationFinished, Qt::DirectConnection);
+}
+
+
+//============================================================================
+CStyleWatchdog::~CStyleWatchdog()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CStyleWatchdog::onOperationFinished(const QString& Operation,
+	double ElapsedMs, const QVariantMap& StageMs)
+{
+	// The asynchronous operations run in a worker thread and do not block
+	// the event loop - only the following stylesheet application does
+	if (Operation == "requestStylesheetUpdate" || Operation.startsWith("openStyle"))
+	{
+		return;
+	}
+
+	if (!d->EpisodeOpen)
+	{
+		d->EpisodeOpen = true;
+		d->EpisodeStartNs = d->Clock.nsecsElapsed() - qint64(ElapsedMs * 1000000.0);
+		d->OperationsMs = 0;
+		d->Breakdown.clear();
+		QTimer::singleShot(0, this, SLOT(onEventLoopResumed()));
+	}
+
+	d->OperationsMs += ElapsedMs;
+	d->Breakdown.insert(Operation, d->Breakdown.value(Operation).toDouble() + ElapsedMs);
+	for (auto itc = StageMs.constBegin(); itc != StageMs.constEnd(); ++itc)
+	{
+		auto Name = Operation + "/" + itc.key();
+		d->Breakdown.insert(Name, d->Breakdown.value(Name).toDouble() + itc.value().toDouble());
+	}
+}
+
+
+//============================================================================
+void CStyleWatchdog::onEventLoopResumed()
+{
+	d->EpisodeOpen = false;
+	double StallMs = (d->Clock.nsecsElapsed() - d->EpisodeStartNs) / 1000000.0;
+	d->Breakdown.insert("events", std::max(0.0, StallMs - d->OperationsMs));
+	d->Episodes++;
+	d->TotalStallMs += StallMs;
+	if (StallMs > d->MaxStallMs)
+	{
+		d->MaxStallMs = StallMs;
+		d->MaxStallBreakdown = d->Breakdown;
+	}
+
+	if (StallMs < d->Threshold)
+	{
+		return;
+	}
+
+	d->Stalls++;
+	if (d->LoggingEnabled)
+	{
+		QStringList Stages;
+		for (auto itc = d->Breakdown.constBegin(); itc != d->Breakdown.constEnd(); ++itc)
+		{
+			Stages.append(QString("%1: %2 ms").arg(itc.key())
+				.arg(itc.value().toDouble(), 0, 'f', 1));
+		}
+		qWarning().noquote() << QString("CStyleWatchdog: event loop blocked "
+			"for %1 ms (%2)").arg(StallMs, 0, 'f', 1).arg(Stages.join(", "));
+	}
+	emit stallDetected(StallMs, d->Breakdown);
+}
+
+
+//============================================================================
+void CStyleWatchdog::setThreshold(double Milliseconds)
+{
+	d->Threshold = Milliseconds;
+}
+
+
+//============================================================================
+double CStyleWatchdog::threshold() const
+{
+	return d->Threshold;
+}
+
+
+//============================================================================
+void CStyleWatchdog::setLoggingEnabled(bool Enabled)
+{
+	d->LoggingEnabled = Enabled;
+}
+
+
+//============================================================================
+bool CStyleWatchdog::isLoggingEnabled() const
+{
+	return d->LoggingEnabled;
+}
+
+
+//============================================================================
+QJsonObject CStyleWatchdog::statistics() const
+{
+	QJsonObject jStatistics;
+	jStatistics.insert("episodes", double(d->Episodes));
+	jStatistics.insert("stalls", double(d->Stalls));
+	jStatistics.insert("threshold_ms", d->Threshold);
+	jStatistics.insert("max_ms", d->MaxStallMs);
+	jStatistics.insert("avg_ms", d->Episodes ? d->TotalStallMs / d->Episodes : 0.0);
+	jStatistics.insert("max_breakdown", QJsonObject::fromVariantMap(d->MaxStallBreakdown));
+	return jStatistics;
+}
+
+
+//============================================================================
+void CStyleWatchdog::resetStatistics()
+{
+	d->Episodes = 0;
+	d->Stalls = 0;
+	d->MaxStallMs = 0;
+	d->TotalStallMs = 0;
+	d->MaxStallBreakdown.clear();
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleWatchdog.cpp
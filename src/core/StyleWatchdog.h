@@ -0,0 +1,109 @@
+#ifndef StyleWatchdogH
+#define StyleWatchdogH
+//============================================================================
+/// \file   StyleWatchdog.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStyleWatchdog class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QVariantMap>
+
+class QJsonObject;
+
+namespace acss
+{
+struct StyleWatchdogPrivate;
+class CStyleProcessor;
+
+/**
+ * Detects event loop stalls caused by style operations.
+ * The watchdog is notified by CStyleProcessor::operationFinished() about
+ * each style operation. The first operation opens a stall episode and posts
+ * a zero timer event. When the event loop processes this event, the episode
+ * is closed - the time from the start of the first operation until then is
+ * the time the event loop has been blocked. This includes the operations
+ * and the delivery of the events posted by them (i.e. polish events).
+ * If the stall exceeds the threshold(), stallDetected() is emitted and a
+ * warning with the stage breakdown is logged.
+ * The watchdog does not use a heartbeat timer and only does some work
+ * after style operations, so it is cheap enough to be enabled in release
+ * builds.
+ * \code
+ * auto Watchdog = new CStyleWatchdog(StyleManager, this);
+ * Watchdog->setThreshold(50);
+ * \endcode
+ */
+class CStyleWatchdog : public QObject
+{
+	Q_OBJECT
+private:
+	StyleWatchdogPrivate* d; ///< private data (pimpl)
+	friend struct StyleWatchdogPrivate;
+
+private slots:
+	void onOperationFinished(const QString& Operation, double ElapsedMs,
+		const QVariantMap& StageMs);
+	void onEventLoopResumed();
+
+public:
+	/**
+	 * Creates a watchdog for the given style processor
+	 */
+	CStyleWatchdog(CStyleProcessor* Processor, QObject* parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CStyleWatchdog();
+
+	/**
+	 * Sets the stall threshold in milliseconds. The default is 100 ms.
+	 */
+	void setThreshold(double Milliseconds);
+
+	/**
+	 * Returns the stall threshold in milliseconds
+	 */
+	double threshold() const;
+
+	/**
+	 * Enables or disables the logging of stalls via qWarning().
+	 * Logging is enabled by default.
+	 */
+	void setLoggingEnabled(bool Enabled);
+
+	/**
+	 * Returns true, if logging is enabled
+	 */
+	bool isLoggingEnabled() const;
+
+	/**
+	 * Returns the collected stall statistics - the number of episodes, the
+	 * number of stalls above the threshold, the maximum and the total
+	 * blocking time and the breakdown of the longest stall
+	 */
+	QJsonObject statistics() const;
+
+	/**
+	 * Clears the collected statistics
+	 */
+	void resetStatistics();
+
+signals:
+	/**
+	 * Emitted if the event loop has been blocked longer than the threshold.
+	 * Breakdown contains the durations of all operations and stages of the
+	 * episode (i.e. "updateStylesheet/render") and the remaining time
+	 * "events" that has been spent delivering events in milliseconds.
+	 */
+	void stallDetected(double StallMs, const QVariantMap& Breakdown);
+}; // class CStyleWatchdog
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleWatchdogH
@@ -0,0 +1,338 @@
+//============================================================================
+/// \file   StylesheetAnalyzer.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStylesheetAnalyzer class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StylesheetAnalyzer.h>
+
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QMap>
+#include <QPair>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <QVector>
+
+namespace acss
+{
+/**
+ * Counters for the analyzed features of a stylesheet
+ */
+struct SelectorStatistics
+{
+	int Compounds = 0;
+	int DescendantCombinators = 0;
+	int ChildCombinators = 0;
+	int PseudoStates = 0;
+	int SubControls = 0;
+	int AttributeSelectors = 0;
+	int ClassSelectors = 0;
+	int IdSelectors = 0;
+
+	int cost() const
+	{
+		return Compounds + 2 * DescendantCombinators + ChildCombinators
+			+ PseudoStates + SubControls + AttributeSelectors + ClassSelectors;
+	}
+
+	void add(const SelectorStatistics& Other)
+	{
+		Compounds += Other.Compounds;
+		DescendantCombinators += Other.DescendantCombinators;
+		ChildCombinators += Other.ChildCombinators;
+		PseudoStates += Other.PseudoStates;
+		SubControls += Other.SubControls;
+		AttributeSelectors += Other.AttributeSelectors;
+		ClassSelectors += Other.ClassSelectors;
+		IdSelectors += Other.IdSelectors;
+	}
+};
+
+
+/**
+ * Aggregated values for all rules of one widget class
+ */
+struct WidgetClassStatistics
+{
+	int Selectors = 0;
+	int IconReferences = 0;
+	int Cost = 0;
+};
+
+
+/**
+ * Analyzes a single selector and returns the type selector (widget class)
+ * of its rightmost compound selector or an empty string for universal
+ * selectors
+ */
+static QString analyzeSelector(const QString& Selector, SelectorStatistics& Statistics)
+{
+	static const QRegularExpression ChildRegex("\\s*>\\s*");
+	static const QRegularExpression SpaceRegex("\\s+");
+	static const QRegularExpression TypeRegex("^[A-Za-z_][\\w-]*");
+	// Attribute selectors may contain spaces and colons, so remove them
+	// before the other parts are counted
+	static const QRegularExpression AttributeRegex("\\[[^\\]]*\\]");
+	static const QRegularExpression SubControlRegex("::[\\w-]+");
+	static const QRegularExpression PseudoStateRegex(":!?[\\w-]+");
+	static const QRegularExpression ClassRegex("\\.[\\w-]+");
+	static const QRegularExpression IdRegex("#[\\w-]+");
+
+	auto countMatches = [](const QRegularExpression& Regex, const QString& Text)
+	{
+		int Count = 0;
+		auto it = Regex.globalMatch(Text);
+		while (it.hasNext())
+		{
+			it.next();
+			Count++;
+		}
+		return Count;
+	};
+
+	auto Normalized = Selector.simplified();
+	Normalized.replace(ChildRegex, ">");
+	QString TypeSelector;
+	const auto ChildParts = Normalized.split('>');
+	Statistics.ChildCombinators += ChildParts.size() - 1;
+	for (const auto& ChildPart : ChildParts)
+	{
+		const auto Compounds = ChildPart.split(SpaceRegex);
+		Statistics.DescendantCombinators += Compounds.size() - 1;
+		for (auto Compound : Compounds)
+		{
+			Statistics.Compounds++;
+			Statistics.AttributeSelectors += countMatches(AttributeRegex, Compound);
+			Compound.remove(AttributeRegex);
+			Statistics.SubControls += countMatches(SubControlRegex, Compound);
+			Compound.remove(SubControlRegex);
+			Statistics.PseudoStates += countMatches(PseudoStateRegex, Compound);
+			Statistics.ClassSelectors += countMatches(ClassRegex, Compound);
+			Statistics.IdSelectors += countMatches(IdRegex, Compound);
+			auto Match = TypeRegex.match(Compound);
+			TypeSelector = Match.hasMatch() ? Match.captured() : QString();
+		}
+	}
+
+	// QWidget rules are checked for all widgets like universal rules
+	if (TypeSelector == "QWidget")
+	{
+		TypeSelector.clear();
+	}
+	return TypeSelector;
+}
+
+
+//============================================================================
+QJsonObject CStylesheetAnalyzer::analyze(const QString& Stylesheet) const
+{
+	static const QRegularExpression CommentRegex("/\\*.*?\\*/",
+		QRegularExpression::DotMatchesEverythingOption);
+	static const QRegularExpression TemplateVariableRegex("\\{\\{.*?\\}\\}");
+	static const QRegularExpression IconUrlRegex("url\\(\\s*[\"']?icon:");
+
+	auto Content = Stylesheet;
+	Content.remove(CommentRegex);
+	Content.replace(TemplateVariableRegex, "0");
+
+	int Rules = 0;
+	int Selectors = 0;
+	int Declarations = 0;
+	int IconReferences = 0;
+	int MaxIconReferencesPerRule = 0;
+	int UniversalCost = 0;
+	int UniversalSelectors = 0;
+	SelectorStatistics Statistics;
+	QMap<QString, WidgetClassStatistics> WidgetClasses;
+
+	int Index = 0;
+	while (true)
+	{
+		int BlockStart = Content.indexOf('{', Index);
+		if (BlockStart < 0)
+		{
+			break;
+		}
+		int BlockEnd = Content.indexOf('}', BlockStart);
+		if (BlockEnd < 0)
+		{
+			BlockEnd = Content.size();
+		}
+
+		auto SelectorText = Content.mid(Index, BlockStart - Index).trimmed();
+		auto Block = Content.mid(BlockStart + 1, BlockEnd - BlockStart - 1);
+		Index = BlockEnd + 1;
+		Rules++;
+		const auto RuleDeclarations = Block.split(';');
+		for (const auto& Declaration : RuleDeclarations)
+		{
+			if (!Declaration.trimmed().isEmpty())
+			{
+				Declarations++;
+			}
+		}
+		int RuleIconReferences = Block.count(IconUrlRegex);
+		IconReferences += RuleIconReferences;
+		MaxIconReferencesPerRule = std::max(MaxIconReferencesPerRule, RuleIconReferences);
+
+		const auto RuleSelectors = SelectorText.split(',');
+		for (const auto& Selector : RuleSelectors)
+		{
+			if (Selector.trimmed().isEmpty())
+			{
+				continue;
+			}
+
+			Selectors++;
+			SelectorStatistics SelectorStats;
+			auto TypeSelector = analyzeSelector(Selector, SelectorStats);
+			Statistics.add(SelectorStats);
+			if (TypeSelector.isEmpty())
+			{
+				UniversalSelectors++;
+				UniversalCost += SelectorStats.cost();
+				continue;
+			}
+
+			auto& WidgetClass = WidgetClasses[TypeSelector];
+			WidgetClass.Selectors++;
+			WidgetClass.IconReferences += RuleIconReferences;
+			WidgetClass.Cost += SelectorStats.cost();
+		}
+	}
+
+	QJsonObject Report;
+	Report.insert("rules", Rules);
+	Report.insert("selectors", Selectors);
+	Report.insert("declarations", Declarations);
+	Report.insert("descendant_combinators", Statistics.DescendantCombinators);
+	Report.insert("child_combinators", Statistics.ChildCombinators);
+	Report.insert("pseudo_states", Statistics.PseudoStates);
+	Report.insert("sub_controls", Statistics.SubControls);
+	Report.insert("attribute_selectors", Statistics.AttributeSelectors);
+	Report.insert("class_selectors", Statistics.ClassSelectors);
+	Report.insert("id_selectors", Statistics.IdSelectors);
+	Report.insert("icon_references", IconReferences);
+	Report.insert("max_icon_references_per_rule", MaxIconReferencesPerRule);
+	Report.insert("universal_selectors", UniversalSelectors);
+	Report.insert("universal_cost", UniversalCost);
+
+	QVector<QPair<QString, WidgetClassStatistics>> SortedClasses;
+	for (auto itc = WidgetClasses.constBegin(); itc != WidgetClasses.constEnd(); ++itc)
+	{
+		SortedClasses.append({itc.key(), itc.value()});
+	}
+	std::stable_sort(SortedClasses.begin(), SortedClasses.end(),
+		[](const QPair<QString, WidgetClassStatistics>& a,
+		   const QPair<QString, WidgetClassStatistics>& b)
+	{
+		return a.second.Cost > b.second.Cost;
+	});
+
+	QJsonArray jWidgetClasses;
+	for (const auto& WidgetClass : SortedClasses)
+	{
+		QJsonObject jWidgetClass;
+		jWidgetClass.insert("name", WidgetClass.first);
+		jWidgetClass.insert("selectors", WidgetClass.second.Selectors);
+		jWidgetClass.insert("icon_references", WidgetClass.second.IconReferences);
+		jWidgetClass.insert("cost", WidgetClass.second.Cost);
+		jWidgetClass.insert("total_cost", WidgetClass.second.Cost + UniversalCost);
+		jWidgetClasses.append(jWidgetClass);
+	}
+	Report.insert("widget_classes", jWidgetClasses);
+	return Report;
+}
+
+
+//============================================================================
+QString CStylesheetAnalyzer::textReport(const QJsonObject& Report)
+{
+	QString Text;
+	QTextStream Stream(&Text);
+	for (auto itc = Report.constBegin(); itc != Report.constEnd(); ++itc)
+	{
+		if (itc.value().isDouble())
+		{
+			Stream << QString("%1%2\n").arg(itc.key(), -32).arg(itc.value().toInt(), 8);
+		}
+	}
+
+	Stream << "\n" << QString("%1%2%3%4\n").arg("Widget class", -32)
+		.arg("Selectors", 10).arg("Icons", 8).arg("Cost", 8);
+	const auto jWidgetClasses = Report.value("widget_classes").toArray();
+	for (const auto& Value : jWidgetClasses)
+	{
+		auto jWidgetClass = Value.toObject();
+		Stream << QString("%1%2%3%4\n")
+			.arg(jWidgetClass.value("name").toString(), -32)
+			.arg(jWidgetClass.value("selectors").toInt(), 10)
+			.arg(jWidgetClass.value("icon_references").toInt(), 8)
+			.arg(jWidgetClass.value("cost").toInt(), 8);
+	}
+	Stream.flush();
+	return Text;
+}
+
+
+//============================================================================
+QStringList CStylesheetAnalyzer::compare(const QJsonObject& Baseline,
+	const QJsonObject& Current, double ThresholdPercent)
+{
+	QStringList Regressions;
+	auto check = [&](const QString& Name, double BaselineValue, double CurrentValue)
+	{
+		if (CurrentValue <= BaselineValue * (1.0 + ThresholdPercent / 100.0))
+		{
+			return;
+		}
+
+		auto Percent = BaselineValue > 0
+			? QString("%1%").arg((CurrentValue / BaselineValue - 1.0) * 100.0, 0, 'f', 1)
+			: QString("new");
+		Regressions.append(QString("%1: %2 -> %3 (+%4)").arg(Name)
+			.arg(BaselineValue).arg(CurrentValue).arg(Percent));
+	};
+
+	for (auto itc = Current.constBegin(); itc != Current.constEnd(); ++itc)
+	{
+		if (itc.value().isDouble())
+		{
+			check(itc.key(), Baseline.value(itc.key()).toDouble(), itc.value().toDouble());
+		}
+	}
+
+	QMap<QString, double> BaselineCosts;
+	const auto jBaselineClasses = Baseline.value("widget_classes").toArray();
+	for (const auto& Value : jBaselineClasses)
+	{
+		auto jWidgetClass = Value.toObject();
+		BaselineCosts.insert(jWidgetClass.value("name").toString(),
+			jWidgetClass.value("total_cost").toDouble());
+	}
+
+	const auto jCurrentClasses = Current.value("widget_classes").toArray();
+	for (const auto& Value : jCurrentClasses)
+	{
+		auto jWidgetClass = Value.toObject();
+		auto Name = jWidgetClass.value("name").toString();
+		// New widget classes are compared against the universal cost of the
+		// baseline because before they were matched by universal rules only
+		check(Name + " total_cost", BaselineCosts.value(Name,
+			Baseline.value("universal_cost").toDouble()),
+			jWidgetClass.value("total_cost").toDouble());
+	}
+
+	return Regressions;
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StylesheetAnalyzer.cpp
@@ -0,0 +1,71 @@
+#ifndef StylesheetAnalyzerH
+#define StylesheetAnalyzerH
+//============================================================================
+/// \file   StylesheetAnalyzer.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStylesheetAnalyzer class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+namespace acss
+{
+/**
+ * Static complexity analysis of a stylesheet or a stylesheet template.
+ * The analyzer counts the rules, selectors and declarations of a stylesheet
+ * and the features that make selector matching in QStyleSheetStyle
+ * expensive (descendant and child combinators, pseudo states, sub-controls,
+ * attribute and class selectors) and the number of url(icon:...) references.
+ *
+ * QStyleSheetStyle checks all rules without a type selector (and all QWidget
+ * rules) for every widget, while rules with a type selector are only checked
+ * for widgets of that class. The analyzer uses this to estimate a matching
+ * cost per widget class. The cost of a single selector is a heuristic value:
+ * each compound selector, pseudo state, sub-control and attribute or class
+ * selector costs 1, each child combinator 1 and each descendant combinator
+ * 2, because it requires a walk through the ancestors of the widget.
+ * \code
+ * CStylesheetAnalyzer Analyzer;
+ * auto Report = Analyzer.analyze(StyleManager.styleSheet());
+ * auto Regressions = CStylesheetAnalyzer::compare(Baseline, Report, 5.0);
+ * \endcode
+ */
+class CStylesheetAnalyzer
+{
+public:
+	/**
+	 * Analyzes the given stylesheet and returns the report.
+	 * The stylesheet may also be a stylesheet template - template variables
+	 * are ignored.
+	 * The report contains the global counters, the estimated cost of the
+	 * universal rules ("universal_cost") and the array "widget_classes" with
+	 * the number of selectors, the icon references and the estimated matching
+	 * cost ("cost" for the class specific rules and "total_cost" including the
+	 * universal rules) per widget class.
+	 */
+	QJsonObject analyze(const QString& Stylesheet) const;
+
+	/**
+	 * Returns a human readable version of the given report
+	 */
+	static QString textReport(const QJsonObject& Report);
+
+	/**
+	 * Compares the Current report with the Baseline report and returns a
+	 * list with one message for each counter or widget class cost that
+	 * increased by more than ThresholdPercent.
+	 * Returns an empty list, if there are no regressions
+	 */
+	static QStringList compare(const QJsonObject& Baseline,
+		const QJsonObject& Current, double ThresholdPercent = 0.0);
+}; // class CStylesheetAnalyzer
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StylesheetAnalyzerH
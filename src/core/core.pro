@@ -0,0 +1,30 @@
+# The core library only depends on QtCore. It contains the style parsing,
+# the stylesheet template processing and the resource generation and can
+# be used in headless tools and on worker threads.
+include(../src.pri)
+
+TARGET = $$qtLibraryTarget(qtadvancedcsscore)
+QT = core
+
+HEADERS += \
+	ColorBatch.h \
+	StyleCache.h \
+	StylePipeline.h \
+	StyleProcessor.h \
+	StyleSchema.h \
+	StyleSimd.h \
+	StyleTemplate.h \
+	StylesheetAnalyzer.h \
+	StyleWatchdog.h
+
+
+SOURCES += \
+	ColorBatch.cpp \
+	StyleCache.cpp \
+	StylePipeline.cpp \
+	StyleProcessor.cpp \
+	StyleTemplate.cpp \
+	StylesheetAnalyzer.cpp \
+	StyleWatchdog.cpp
+
+headers.files=$$HEADERS
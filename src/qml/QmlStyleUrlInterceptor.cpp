@@ -12,12 +12,12 @@
 
 #include <QDebug>
 
-#include "StyleManager.h"
+#include "StyleProcessor.h"
 
 namespace acss
 {
 //=============================================================================
-CQmlStyleUrlInterceptor::CQmlStyleUrlInterceptor(CStyleManager* StyleManager)
+CQmlStyleUrlInterceptor::CQmlStyleUrlInterceptor(CStyleProcessor* StyleManager)
     : m_StyleManager{StyleManager}
 {}
 
@@ -32,7 +32,7 @@ QUrl CQmlStyleUrlInterceptor::intercept(const QUrl& path, DataType type)
                                        + '/' + path.path());
         }
         qWarning() << "AdvancedStylesheet Error: CQmlStyleUrlInterceptor has no "
-                      "valid CStyleManager!";
+                      "valid CStyleProcessor!";
     }
     return path;
 }
@@ -14,7 +14,7 @@
 
 namespace acss
 {
-class CStyleManager;
+class CStyleProcessor;
 
 /**
  * @brief The CQmlStyleUrlInterceptor class provides a URL interceptor that can be
@@ -42,7 +42,8 @@ class CStyleManager;
  * @endcode
  * The @c CQmlStyleUrlInterceptor will intercept all URLs with the "icon:" prefix
  * and turn them into absolute paths (with the help of the @c CStyleManager
- * instance passed in the constructor) that can be understood by QML.
+ * or @c CStyleProcessor instance passed in the constructor) that can be
+ * understood by QML.
  */
 class CQmlStyleUrlInterceptor : public QQmlAbstractUrlInterceptor
 {
@@ -52,13 +53,13 @@ public:
      *
      * @param StyleManager The Style Manager to use for resolving the URLs
      */
-    CQmlStyleUrlInterceptor(CStyleManager* StyleManager);
+    CQmlStyleUrlInterceptor(CStyleProcessor* StyleManager);
 
     // implements QQmlAbstractUrlInterceptor ---------------------------------
     QUrl intercept(const QUrl& path, DataType type) override;
 
 private:
-    CStyleManager* m_StyleManager;
+    CStyleProcessor* m_StyleManager;
 };
 
 }  // namespace acss
@@ -0,0 +1,21 @@
+# Adapter library for QML applications. It provides the URL interceptor
+# for the icon: scheme.
+include(../src.pri)
+
+TARGET = $$qtLibraryTarget(qtadvancedcssqml)
+QT += core qml
+
+INCLUDEPATH += ../core
+DEPENDPATH += ../core
+LIBS += -L$${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core
+include(../../acss.pri)
+
+HEADERS += \
+	QmlStyleUrlInterceptor.h
+
+
+SOURCES += \
+	QmlStyleUrlInterceptor.cpp
+
+headers.files=$$HEADERS
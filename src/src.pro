@@ -1,52 +1,9 @@
-ACSS_OUT_ROOT = $${OUT_PWD}/..
-CONFIG += c++14
-CONFIG += debug_and_release
-TARGET = $$qtLibraryTarget(qtadvancedcss)
-DEFINES += QT_DEPRECATED_WARNINGS
-TEMPLATE = lib
-DESTDIR = $${ACSS_OUT_ROOT}/lib
-QT += core gui widgets qml
+TEMPLATE = subdirs
 
-!acssBuildStatic {
-	CONFIG += shared
-    DEFINES += ACSS_SHARED_EXPORT
-}
-acsBuildStatic {
-	CONFIG += staticlib
-    DEFINES += ACSS_STATIC
-}
+SUBDIRS = \
+	core \
+	widgets \
+	qml
 
-windows {
-	# MinGW
-	*-g++* {
-		QMAKE_CXXFLAGS += -Wall -Wextra -pedantic
-	}
-	# MSVC
-	*-msvc* {
-                QMAKE_CXXFLAGS += /utf-8
-        }
-}
-
-#RESOURCES += ads.qrc
-
-HEADERS += \
-	QmlStyleUrlInterceptor.h \
-	StyleManager.h
-
-
-SOURCES += \
-	QmlStyleUrlInterceptor.cpp \
-	StyleManager.cpp
-
-
-isEmpty(PREFIX){
-	PREFIX=../installed
-	warning("Install Prefix not set")
-}
-
-headers.path=$$PREFIX/include
-headers.files=$$HEADERS
-target.path=$$PREFIX/lib
-INSTALLS += headers target
-
-DISTFILES +=
+widgets.depends = core
+qml.depends = core
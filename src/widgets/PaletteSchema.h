@@ -0,0 +1,72 @@
+#ifndef PaletteSchemaH
+#define PaletteSchemaH
+//============================================================================
+/// \file   PaletteSchema.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Compile time lookup tables for the palette of the style JSON file
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleSchema.h>
+
+#include <QPalette>
+
+namespace acss
+{
+/**
+ * Palette color roles of the style JSON file. The names are generated from
+ * the enum values, so a name can never differ from its role.
+ */
+#define ACSS_COLOR_ROLE(Role) {#Role, QPalette::Role}
+constexpr SchemaEntry<QPalette::ColorRole> ColorRoleEntries[] = {
+	ACSS_COLOR_ROLE(WindowText),
+	ACSS_COLOR_ROLE(Button),
+	ACSS_COLOR_ROLE(Light),
+	ACSS_COLOR_ROLE(Midlight),
+	ACSS_COLOR_ROLE(Dark),
+	ACSS_COLOR_ROLE(Mid),
+	ACSS_COLOR_ROLE(Text),
+	ACSS_COLOR_ROLE(BrightText),
+	ACSS_COLOR_ROLE(ButtonText),
+	ACSS_COLOR_ROLE(Base),
+	ACSS_COLOR_ROLE(Window),
+	ACSS_COLOR_ROLE(Shadow),
+	ACSS_COLOR_ROLE(Highlight),
+	ACSS_COLOR_ROLE(HighlightedText),
+	ACSS_COLOR_ROLE(Link),
+	ACSS_COLOR_ROLE(LinkVisited),
+	ACSS_COLOR_ROLE(AlternateBase),
+	ACSS_COLOR_ROLE(NoRole),
+	ACSS_COLOR_ROLE(ToolTipBase),
+	ACSS_COLOR_ROLE(ToolTipText),
+#if QT_VERSION >= 0x050C00
+	ACSS_COLOR_ROLE(PlaceholderText)
+#endif
+};
+#undef ACSS_COLOR_ROLE
+
+constexpr auto ColorRoles = makeSchemaTable<64>(ColorRoleEntries);
+static_assert(ColorRoles.isValid(), "Duplicate or colliding palette color roles");
+static_assert(ColorRoles.find("ButtonText") >= 0 && ColorRoles.find("WindowText") >= 0
+	&& ColorRoles.find("ButtonTextd") < 0, "Invalid palette color role table");
+
+
+/**
+ * Palette color groups of the style JSON file
+ */
+constexpr SchemaEntry<QPalette::ColorGroup> ColorGroupEntries[] = {
+	{"active", QPalette::Active},
+	{"disabled", QPalette::Disabled},
+	{"inactive", QPalette::Inactive}
+};
+
+constexpr auto ColorGroups = makeSchemaTable<8>(ColorGroupEntries);
+static_assert(ColorGroups.isValid(), "Duplicate or colliding palette color groups");
+static_assert(ColorGroups.find("active") >= 0 && ColorGroups.find("disabled") >= 0
+	&& ColorGroups.find("inactive") >= 0, "Invalid palette color group table");
+} // namespace acss
+//-----------------------------------------------------------------------------
+#endif // PaletteSchemaH
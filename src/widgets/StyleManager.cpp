@@ -0,0 +1,1093 @@
+//============================================================================
+/// \file   StyleManager.cpp
+/// \author Uwe Kindler
+/// \date   13.12.2021
+/// \brief  Implementation of CStyleManager class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleManager.h>
+
+#include <PaletteSchema.h>
+#include <StyleCache.h>
+#include <StyleSchema.h>
+
+#include <algorithm>
+
+#include <QMap>
+#include <QDebug>
+#include <QDir>
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QFileInfo>
+#include <QFontDatabase>
+#include <QJsonObject>
+#include <QIcon>
+#include <QImageReader>
+#include <QApplication>
+#include <QPalette>
+#include <QPixmap>
+#include <QStyleHints>
+#include <QRegularExpression>
+#include <QScreen>
+#include <QSet>
+#include <QWidget>
+#include <QWindow>
+
+#include <qpa/qplatformtheme.h>
+#include <private/qguiapplication_p.h>
+
+#include <cmath>
+
+namespace acss
+{
+struct PaletteColorEntry
+{
+	QPalette::ColorGroup Group;
+	QPalette::ColorRole Role;
+	QString ColorVariable;
+
+	PaletteColorEntry(QPalette::ColorGroup group = QPalette::Active,
+		QPalette::ColorRole role = QPalette::NoRole,
+		const QString& variable = QString())
+		: Group(group), Role(role), ColorVariable(variable) {}
+
+	bool isValid() const
+	{
+		return !ColorVariable.isEmpty() && Role != QPalette::NoRole;
+	}
+};
+
+
+/**
+ * Icon with pre-rasterized pixmaps and the size of these pixmaps
+ */
+struct RasterIcon
+{
+	QIcon Icon;
+	qint64 Bytes = 0;
+};
+
+
+/**
+ * Renders the SVG Content with the given pixel size multiplied by Scale.
+ * An invalid Size uses the size of the SVG document. The raster is taken
+ * from or stored in the given artifact cache. The function is thread safe,
+ * so it can be called in the workers of the generation pipeline.
+ * If Png is given, it receives the PNG data of the raster.
+ */
+static QImage rasterizeSvg(CStyleCache& Cache, const QByteArray& Content,
+	const QSize& Size, int Scale, QByteArray* Png = nullptr)
+{
+	auto Key = QString("%1|%2x%3|%4").arg(QString::fromLatin1(
+		QCryptographicHash::hash(Content, QCryptographicHash::Sha1).toHex()))
+		.arg(Size.width()).arg(Size.height()).arg(Scale);
+	QByteArray Data;
+	QImage Image;
+	if (Cache.find(CStyleCache::RasterArtifact, Key, Data))
+	{
+		Image.loadFromData(Data, "PNG");
+	}
+
+	if (Image.isNull())
+	{
+		QBuffer SvgBuffer;
+		SvgBuffer.setData(Content);
+		QImageReader Reader(&SvgBuffer, "svg");
+		auto PixelSize = Size.isValid() ? Size : Reader.size();
+		Reader.setScaledSize(PixelSize * Scale);
+		Image = Reader.read();
+		if (Image.isNull())
+		{
+			return QImage();
+		}
+
+		Data.clear();
+		QBuffer Buffer(&Data);
+		Buffer.open(QIODevice::WriteOnly);
+		Image.save(&Buffer, "PNG");
+		Cache.insert(CStyleCache::RasterArtifact, Key, Data);
+	}
+
+	if (Png)
+	{
+		*Png = Data;
+	}
+	return Image;
+}
+
+
+/**
+ * Writes the PNG rasters of the stylesheet image FilePath: name.png with the
+ * size of the SVG document and name@Nx.png for all given Scales
+ */
+static bool writeStylesheetImages(CStyleCache& Cache, const QString& FilePath,
+	const QByteArray& Content, const QList<int>& Scales)
+{
+	auto BaseName = FilePath;
+	if (BaseName.endsWith(".svg"))
+	{
+		BaseName.chop(4);
+	}
+
+	for (int Scale : QList<int>{1} + Scales)
+	{
+		QByteArray Png;
+		if (rasterizeSvg(Cache, Content, QSize(), Scale, &Png).isNull())
+		{
+			return false;
+		}
+
+		auto Suffix = (Scale > 1) ? QString("@%1x.png").arg(Scale) : QString(".png");
+		QFile PngFile(BaseName + Suffix);
+		if (!PngFile.open(QIODevice::WriteOnly) || PngFile.write(Png) != Png.size())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/**
+ * Private data class of CStyleManager class (pimpl)
+ */
+struct StyleManagerPrivate
+{
+	CStyleManager *_this;
+	QVector<PaletteColorEntry> PaletteColors;
+	QString PaletteBaseColor;
+	mutable QIcon Icon;
+	QList<int> RasterIconSizes = {16, 24, 32};
+	QList<qreal> ScreenRatios;
+	mutable QMap<QString, RasterIcon> RasterIcons;
+	QSet<QWindow*> WatchedWindows;
+	bool RasterizeStylesheetImages = false;
+	QString LightTheme;
+	QString DarkTheme;
+	bool FollowSystemColorScheme = false;
+	bool SystemDarkMode = false;
+	bool SettingPalette = false;
+	QPalette PlatformPalette;
+	bool PlatformPaletteCaptured = false;
+
+	/**
+	 * Private data constructor
+	 */
+	StyleManagerPrivate(CStyleManager *_public);
+
+	/**
+	 * Register the style fonts to the font database
+	 */
+	void addFonts(QDir* Dir = nullptr);
+
+	/**
+	 * Parse palette from JSON file
+	 */
+	void parsePaletteFromJson();
+
+	/**
+	 * Parse palette color group from the given palette json parameters
+	 */
+	void parsePaletteColorGroup(QJsonObject& jPalette, QPalette::ColorGroup ColorGroup);
+
+	/**
+	 * Updates the list of device pixel ratios from the connected screens.
+	 * Removed is a screen that is about to be removed.
+	 */
+	void updateScreenRatios(QScreen* Removed = nullptr);
+
+	/**
+	 * Rebuilds the icon sets if the device pixel ratio of the given screen
+	 * changes
+	 */
+	void watchScreen(QScreen* Screen);
+
+	/**
+	 * Checks the device pixel ratios again if the given window moves to
+	 * another screen
+	 */
+	void watchWindow(QWindow* Window);
+
+	/**
+	 * Returns the integer scale factors >= 2 of the @Nx stylesheet images
+	 * for the current screen ratios
+	 */
+	QList<int> stylesheetImageScales() const;
+
+	/**
+	 * Rasterizes the given SVG file for the given logical size and device
+	 * pixel ratio or takes the raster from the artifact cache
+	 */
+	QPixmap rasterize(const QString& FilePath, int Size, qreal Ratio) const;
+
+	/**
+	 * Creates the icon with pixmaps for all sizes and screen ratios
+	 */
+	RasterIcon createRasterIcon(const QString& Name) const;
+
+	/**
+	 * Drops all icon sets. They are created again if they are requested via
+	 * resourceIcon().
+	 */
+	void invalidateRasterIcons();
+
+	/**
+	 * Creates a palette from the given theme colors
+	 */
+	QPalette generatePalette(const QMap<QString, QString>& ThemeColors) const;
+
+	/**
+	 * Assigns the given palette to the application. The resulting palette
+	 * change event is not evaluated by the color scheme detection.
+	 */
+	void setApplicationPalette(const QPalette& Palette);
+
+	/**
+	 * Stores the current application palette as the palette of the platform
+	 * if it has not been overridden by the style manager yet
+	 */
+	void capturePlatformPalette();
+
+	/**
+	 * Renders the light and the dark system theme into the artifact cache
+	 */
+	void prerenderSystemThemes();
+
+	/**
+	 * Reads the system color scheme and applies the matching theme if it
+	 * changed
+	 */
+	void onSystemColorSchemeChanged();
+};// struct StyleManagerPrivate
+
+
+//============================================================================
+StyleManagerPrivate::StyleManagerPrivate(
+    CStyleManager *_public) :
+	_this(_public)
+{
+
+}
+
+
+//============================================================================
+void StyleManagerPrivate::addFonts(QDir* Dir)
+{
+	// I dont't know, if this is the right way to detect, if there are any
+	// widgets. The call to QFontDatabase::addApplicationFont() will crash, if
+	// there are no widgets
+	if (qApp->allWidgets().isEmpty())
+	{
+		return;
+	}
+
+	if (!Dir)
+	{
+		QDir FontsDir(_this->path(CStyleManager::FontsLocation));
+		addFonts(&FontsDir);
+	}
+	else
+	{
+		auto Folders = Dir->entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+		for (auto Folder : Folders)
+		{
+			Dir->cd(Folder);
+			addFonts(Dir);
+			Dir->cdUp();
+		}
+
+		auto FontFiles = Dir->entryList({"*.ttf"}, QDir::Files);
+		for (auto Font : FontFiles)
+		{
+            QString FontFilename = Dir->absoluteFilePath(Font);
+			QFontDatabase::addApplicationFont(FontFilename);
+		}
+	}
+}
+
+
+//============================================================================
+void StyleManagerPrivate::parsePaletteFromJson()
+{
+	PaletteBaseColor = QString();
+	PaletteColors.clear();
+	auto jPalette = _this->styleParameters().value(styleJsonKey(PaletteKey)).toObject();
+	if (jPalette.isEmpty())
+	{
+		return;
+	}
+
+	PaletteBaseColor = jPalette.value(QLatin1String("base_color")).toString();
+	for (const auto& Entry : ColorGroupEntries)
+	{
+		parsePaletteColorGroup(jPalette, Entry.Value);
+	}
+}
+
+
+//============================================================================
+void StyleManagerPrivate::parsePaletteColorGroup(QJsonObject& jPalette, QPalette::ColorGroup ColorGroup)
+{
+	auto jColorGroup = jPalette.value(QLatin1String(ColorGroups.name(ColorGroup))).toObject();
+	if (jColorGroup.isEmpty())
+	{
+		return;
+	}
+
+	for (auto itc = jColorGroup.constBegin(); itc != jColorGroup.constEnd(); ++itc)
+	{
+		int RoleIndex = ColorRoles.indexOf(itc.key());
+		if (RoleIndex < 0)
+		{
+			qWarning() << "Unknown palette color role" << itc.key();
+			continue;
+		}
+
+		auto ColorRole = ColorRoleEntries[RoleIndex].Value;
+		if (QPalette::NoRole == ColorRole)
+		{
+			continue;
+		}
+
+		this->PaletteColors.append({ColorGroup, ColorRole, itc.value().toString()});
+		if (ColorGroup != QPalette::Active)
+		{
+			continue;
+		}
+	}
+}
+
+
+//============================================================================
+void StyleManagerPrivate::updateScreenRatios(QScreen* Removed)
+{
+	QList<qreal> Ratios;
+	for (auto Screen : QGuiApplication::screens())
+	{
+		if (Screen != Removed && !Ratios.contains(Screen->devicePixelRatio()))
+		{
+			Ratios.append(Screen->devicePixelRatio());
+		}
+	}
+	std::sort(Ratios.begin(), Ratios.end());
+	if (Ratios == ScreenRatios)
+	{
+		return;
+	}
+
+	auto Scales = stylesheetImageScales();
+	ScreenRatios = Ratios;
+	invalidateRasterIcons();
+
+	// The stylesheet images need to be rendered for the new scale factors
+	if (RasterizeStylesheetImages && Scales != stylesheetImageScales()
+	 && !_this->currentStyle().isEmpty())
+	{
+		_this->requestStylesheetUpdate(false);
+	}
+}
+
+
+//============================================================================
+void StyleManagerPrivate::watchScreen(QScreen* Screen)
+{
+	// There is no signal for device pixel ratio changes. Depending on the
+	// platform, a changed scale factor changes the logical or the physical
+	// DPI or the geometry, so the ratios are checked again for all of them
+	auto Update = [this](){updateScreenRatios();};
+	QObject::connect(Screen, &QScreen::logicalDotsPerInchChanged, _this, Update);
+	QObject::connect(Screen, &QScreen::physicalDotsPerInchChanged, _this, Update);
+	QObject::connect(Screen, &QScreen::geometryChanged, _this, Update);
+}
+
+
+//============================================================================
+void StyleManagerPrivate::watchWindow(QWindow* Window)
+{
+	if (!Window || WatchedWindows.contains(Window))
+	{
+		return;
+	}
+
+	WatchedWindows.insert(Window);
+	QObject::connect(Window, &QWindow::screenChanged, _this,
+		[this](){updateScreenRatios();});
+	QObject::connect(Window, &QObject::destroyed, _this,
+		[this, Window](){WatchedWindows.remove(Window);});
+}
+
+
+//============================================================================
+QList<int> StyleManagerPrivate::stylesheetImageScales() const
+{
+	// Qt looks up the @Nx file with the rounded up device pixel ratio
+	QList<int> Scales;
+	for (auto Ratio : ScreenRatios)
+	{
+		int Scale = int(std::ceil(Ratio));
+		if (Scale > 1 && !Scales.contains(Scale))
+		{
+			Scales.append(Scale);
+		}
+	}
+	return Scales;
+}
+
+
+//============================================================================
+QPixmap StyleManagerPrivate::rasterize(const QString& FilePath, int Size,
+	qreal Ratio) const
+{
+	// The raster is keyed by the SVG content because every generation
+	// writes the resource files again
+	QFile SvgFile(FilePath);
+	if (!SvgFile.open(QIODevice::ReadOnly))
+	{
+		return QPixmap();
+	}
+
+	int PixelSize = qRound(Size * Ratio);
+	auto Image = rasterizeSvg(_this->artifactCache(), SvgFile.readAll(),
+		QSize(PixelSize, PixelSize), 1);
+	if (Image.isNull())
+	{
+		return QPixmap();
+	}
+
+	auto Pixmap = QPixmap::fromImage(Image);
+	Pixmap.setDevicePixelRatio(Ratio);
+	return Pixmap;
+}
+
+
+//============================================================================
+RasterIcon StyleManagerPrivate::createRasterIcon(const QString& Name) const
+{
+	RasterIcon Icon;
+	auto FilePath = _this->currentStyleOutputPath() + "/" + Name;
+	for (auto Ratio : ScreenRatios)
+	{
+		for (auto Size : RasterIconSizes)
+		{
+			auto Pixmap = rasterize(FilePath, Size, Ratio);
+			if (!Pixmap.isNull())
+			{
+				Icon.Icon.addPixmap(Pixmap);
+				Icon.Bytes += qint64(Pixmap.width()) * Pixmap.height() * Pixmap.depth() / 8;
+			}
+		}
+	}
+	return Icon;
+}
+
+
+//============================================================================
+void StyleManagerPrivate::invalidateRasterIcons()
+{
+	if (RasterIcons.isEmpty())
+	{
+		return;
+	}
+
+	RasterIcons.clear();
+	emit _this->resourceIconsChanged();
+}
+
+
+//============================================================================
+CStyleManager::CStyleManager(QObject* parent) :
+	CStyleProcessor(parent),
+	d(new StyleManagerPrivate(this))
+{
+	connect(this, &CStyleProcessor::stylesheetChanged, this,
+		[this](){d->invalidateRasterIcons();});
+	connect(this, &CStyleProcessor::currentStyleChanged, this,
+		[this](){d->prerenderSystemThemes();});
+	if (!qApp)
+	{
+		return;
+	}
+
+#if QT_VERSION >= 0x060500
+	connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged,
+		this, [this](){d->onSystemColorSchemeChanged();});
+#endif
+
+	for (auto Screen : QGuiApplication::screens())
+	{
+		d->watchScreen(Screen);
+	}
+	d->updateScreenRatios();
+	connect(qApp, &QGuiApplication::screenAdded, this, [this](QScreen* Screen)
+	{
+		d->watchScreen(Screen);
+		d->updateScreenRatios();
+	});
+	connect(qApp, &QGuiApplication::screenRemoved, this, [this](QScreen* Screen)
+	{
+		d->updateScreenRatios(Screen);
+	});
+
+	// A window that moves to another screen may see a changed device pixel
+	// ratio before the screen signals it
+	for (auto Window : QGuiApplication::topLevelWindows())
+	{
+		d->watchWindow(Window);
+	}
+	connect(qApp, &QGuiApplication::focusWindowChanged, this, [this](QWindow* Window)
+	{
+		d->watchWindow(Window);
+	});
+}
+
+
+//============================================================================
+CStyleManager::~CStyleManager()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CStyleManager::onCurrentStyleLoaded()
+{
+	d->Icon = QIcon();
+	d->parsePaletteFromJson();
+	d->addFonts();
+}
+
+
+//============================================================================
+void CStyleManager::onStylesheetUpdate()
+{
+	updateApplicationPaletteColors();
+}
+
+
+//============================================================================
+QColor CStyleManager::themeColor(const QString& VariableId) const
+{
+	auto ColorString = themeColorVariables().value(VariableId, QString());
+	if (ColorString.isEmpty())
+	{
+		return QColor();
+	}
+
+	return QColor(ColorString);
+}
+
+
+//============================================================================
+bool CStyleManager::processStyleTemplate()
+{
+	updateApplicationPaletteColors();
+	return CStyleProcessor::processStyleTemplate();
+}
+
+
+//============================================================================
+const QIcon& CStyleManager::styleIcon() const
+{
+	auto IconPath = styleIconPath();
+	if (d->Icon.isNull() && !IconPath.isEmpty())
+	{
+		d->Icon = QIcon(IconPath);
+	}
+
+	return d->Icon;
+}
+
+
+//============================================================================
+QPalette StyleManagerPrivate::generatePalette(
+	const QMap<QString, QString>& ThemeColors) const
+{
+	QPalette Palette = qApp->palette();
+	if (!PaletteBaseColor.isEmpty())
+	{
+		QColor Color(ThemeColors.value(PaletteBaseColor));
+		if (Color.isValid())
+		{
+			Palette = QPalette(Color);
+		}
+	}
+
+	for (const auto& Entry : PaletteColors)
+	{
+		QColor Color(ThemeColors.value(Entry.ColorVariable));
+		if (Color.isValid())
+		{
+			Palette.setColor(Entry.Group, Entry.Role, Color);
+		}
+	}
+
+	return Palette;
+}
+
+
+//============================================================================
+void StyleManagerPrivate::setApplicationPalette(const QPalette& Palette)
+{
+	capturePlatformPalette();
+	SettingPalette = true;
+	qApp->setPalette(Palette);
+	SettingPalette = false;
+}
+
+
+//============================================================================
+void StyleManagerPrivate::capturePlatformPalette()
+{
+	if (PlatformPaletteCaptured || !qApp)
+	{
+		return;
+	}
+
+	PlatformPalette = qApp->palette();
+	PlatformPaletteCaptured = true;
+}
+
+
+//============================================================================
+void StyleManagerPrivate::prerenderSystemThemes()
+{
+	if (!FollowSystemColorScheme || _this->currentStyle().isEmpty())
+	{
+		return;
+	}
+
+	// The scope generation stores the stylesheet and the resources in the
+	// artifact cache, so the following theme switch takes them from there.
+	// The scope of the active theme is not needed anymore, so only the
+	// resources of the inactive theme are kept on disk.
+	for (const auto& Theme : {LightTheme, DarkTheme})
+	{
+		QString Scope = (Theme == LightTheme) ? "systemlight" : "systemdark";
+		if (Theme.isEmpty() || Theme == _this->currentTheme())
+		{
+			_this->removeScope(Scope);
+		}
+		else if (_this->scopedTheme(Scope) != Theme)
+		{
+			_this->generateScopedStyle(Scope, Theme);
+		}
+	}
+}
+
+
+//============================================================================
+void StyleManagerPrivate::onSystemColorSchemeChanged()
+{
+	bool DarkMode = _this->isSystemDarkMode();
+	if (DarkMode == SystemDarkMode)
+	{
+		return;
+	}
+
+	SystemDarkMode = DarkMode;
+	_this->applySystemColorScheme();
+}
+
+
+//============================================================================
+QPalette CStyleManager::generateThemePalette() const
+{
+	return d->generatePalette(themeColorVariables());
+}
+
+
+//============================================================================
+QPalette CStyleManager::generateScopedPalette(const QString& Scope) const
+{
+	return d->generatePalette(scopedThemeColorVariables(Scope));
+}
+
+
+//============================================================================
+void CStyleManager::updateApplicationPaletteColors()
+{
+	d->setApplicationPalette(generateThemePalette());
+}
+
+
+//============================================================================
+bool CStyleManager::updateApplicationStyle()
+{
+	if (!runUpdatePipeline(false))
+	{
+		return false;
+	}
+
+	applyToApplication();
+	emitStylesheetChangedIfModified();
+	return true;
+}
+
+
+//============================================================================
+QJsonObject CStyleManager::memoryFootprint() const
+{
+	auto jItems = CStyleProcessor::memoryFootprint();
+	qint64 PaletteBytes = d->PaletteColors.capacity() * qint64(sizeof(PaletteColorEntry))
+		+ d->PaletteBaseColor.capacity() * qint64(sizeof(QChar));
+	for (const auto& Entry : d->PaletteColors)
+	{
+		PaletteBytes += Entry.ColorVariable.capacity() * qint64(sizeof(QChar));
+	}
+	jItems.insert("palette_entries", double(PaletteBytes));
+
+	// The icon engine does not expose its pixmap cache - only the sizes of
+	// the pixmaps it can provide
+	qint64 IconBytes = 0;
+	for (const auto& Size : d->Icon.availableSizes())
+	{
+		IconBytes += Size.width() * Size.height() * 4;
+	}
+	jItems.insert("style_icon_estimate", double(IconBytes));
+
+	qint64 RasterBytes = 0;
+	for (const auto& Icon : d->RasterIcons)
+	{
+		RasterBytes += Icon.Bytes;
+	}
+	jItems.insert("raster_icons", double(RasterBytes));
+	return jItems;
+}
+
+
+//============================================================================
+QIcon CStyleManager::resourceIcon(const QString& Name) const
+{
+	auto it = d->RasterIcons.find(Name);
+	if (it == d->RasterIcons.end())
+	{
+		it = d->RasterIcons.insert(Name, d->createRasterIcon(Name));
+	}
+	return it.value().Icon;
+}
+
+
+//============================================================================
+void CStyleManager::setRasterIconSizes(const QList<int>& Sizes)
+{
+	if (Sizes == d->RasterIconSizes)
+	{
+		return;
+	}
+
+	d->RasterIconSizes = Sizes;
+	d->invalidateRasterIcons();
+}
+
+
+//============================================================================
+QList<int> CStyleManager::rasterIconSizes() const
+{
+	return d->RasterIconSizes;
+}
+
+
+//============================================================================
+QList<qreal> CStyleManager::screenDevicePixelRatios() const
+{
+	return d->ScreenRatios;
+}
+
+
+//============================================================================
+void CStyleManager::setRasterizeStylesheetImages(bool Rasterize)
+{
+	d->RasterizeStylesheetImages = Rasterize;
+}
+
+
+//============================================================================
+bool CStyleManager::isRasterizingStylesheetImages() const
+{
+	return d->RasterizeStylesheetImages;
+}
+
+
+//============================================================================
+ResourceProcessor CStyleManager::resourceProcessor() const
+{
+	ResourceProcessor Processor;
+	if (!d->RasterizeStylesheetImages)
+	{
+		return Processor;
+	}
+
+	auto Scales = d->stylesheetImageScales();
+	auto Cache = &artifactCache();
+	Processor.Process = [Scales, Cache](const QString& FilePath,
+		const QByteArray& Content)
+	{
+		return writeStylesheetImages(*Cache, FilePath, Content, Scales);
+	};
+	Processor.StylesheetImageSuffix = "png";
+	return Processor;
+}
+
+
+//============================================================================
+void CStyleManager::requestApplicationStyleUpdate()
+{
+	requestStylesheetUpdate(true);
+}
+
+
+//============================================================================
+void CStyleManager::openApplicationStyle(const QString& Style, const QString& Theme)
+{
+	openStyle(Style, Theme, true);
+}
+
+
+//============================================================================
+bool CStyleManager::applyScopedTheme(QWidget* Widget, const QString& Theme,
+	const QString& Scope)
+{
+	auto ScopeName = Scope;
+	if (ScopeName.isEmpty())
+	{
+		static const QRegularExpression InvalidRegex("[^A-Za-z0-9]");
+		ScopeName = QString(Theme).remove(InvalidRegex);
+	}
+
+	if (scopedTheme(ScopeName) != Theme && !generateScopedStyle(ScopeName, Theme))
+	{
+		return false;
+	}
+
+	// Like in applyToApplication(), the palette is set first and painting
+	// is suspended, so that the subtree is repolished only once
+	auto Window = Widget->window();
+	bool Suspend = Window->isVisible() && Window->updatesEnabled();
+	if (Suspend)
+	{
+		Window->setUpdatesEnabled(false);
+	}
+	Widget->setPalette(generateScopedPalette(ScopeName));
+	Widget->setStyleSheet(scopedStylesheet(ScopeName));
+	if (Suspend)
+	{
+		Window->setUpdatesEnabled(true);
+	}
+	return true;
+}
+
+
+//============================================================================
+void CStyleManager::setSystemColorSchemeThemes(const QString& LightTheme,
+	const QString& DarkTheme)
+{
+	d->LightTheme = LightTheme;
+	d->DarkTheme = DarkTheme;
+	d->prerenderSystemThemes();
+}
+
+
+//============================================================================
+void CStyleManager::setFollowSystemColorScheme(bool Follow)
+{
+	if (Follow == d->FollowSystemColorScheme)
+	{
+		return;
+	}
+
+	d->FollowSystemColorScheme = Follow;
+	if (!Follow)
+	{
+		qApp->removeEventFilter(this);
+		return;
+	}
+
+	d->capturePlatformPalette();
+	d->SystemDarkMode = isSystemDarkMode();
+	qApp->installEventFilter(this);
+	applySystemColorScheme();
+	d->prerenderSystemThemes();
+}
+
+
+//============================================================================
+bool CStyleManager::isFollowingSystemColorScheme() const
+{
+	return d->FollowSystemColorScheme;
+}
+
+
+//============================================================================
+bool CStyleManager::isSystemDarkMode() const
+{
+#if QT_VERSION >= 0x060500
+	auto ColorScheme = QGuiApplication::styleHints()->colorScheme();
+	if (ColorScheme != Qt::ColorScheme::Unknown)
+	{
+		return ColorScheme == Qt::ColorScheme::Dark;
+	}
+#endif
+	// Without a color scheme hint, the palette of the platform decides.
+	// The application palette is the theme palette of the style manager
+	// after the first theme switch, so it can not be used.
+	if (d->SettingPalette || !qApp)
+	{
+		return d->SystemDarkMode;
+	}
+	return platformPalette().color(QPalette::Window).lightness() < 128;
+}
+
+
+//============================================================================
+QPalette CStyleManager::platformPalette() const
+{
+	auto Theme = QGuiApplicationPrivate::platformTheme();
+	auto Palette = Theme ? Theme->palette(QPlatformTheme::SystemPalette) : nullptr;
+	if (Palette)
+	{
+		return *Palette;
+	}
+
+	// Platforms without theme palette only change the application palette
+	return d->PlatformPaletteCaptured ? d->PlatformPalette : qApp->palette();
+}
+
+
+//============================================================================
+bool CStyleManager::applySystemColorScheme()
+{
+	auto Theme = d->SystemDarkMode ? d->DarkTheme : d->LightTheme;
+	if (Theme.isEmpty() || currentStyle().isEmpty())
+	{
+		return false;
+	}
+
+	if (Theme == currentTheme())
+	{
+		return true;
+	}
+
+	// The nested theme switch and stylesheet update are recorded as stages
+	// of this operation
+	QElapsedTimer Timer;
+	Timer.start();
+	beginOperation();
+	bool Result = setCurrentTheme(Theme) && updateApplicationStyle();
+	endOperation("applySystemColorScheme", Timer.nsecsElapsed());
+	if (!Result)
+	{
+		return false;
+	}
+	// The theme that is not active anymore becomes the one that is rendered
+	// ahead of time
+	d->prerenderSystemThemes();
+	return true;
+}
+
+
+//============================================================================
+bool CStyleManager::eventFilter(QObject* Object, QEvent* Event)
+{
+	// Qt versions without color scheme hint only report the new palette of
+	// the platform. The application palette set by the style manager
+	// overrides the platform palette, so a change of the platform theme
+	// does not cause an application palette change but only theme change
+	// events.
+#if QT_VERSION < 0x060500
+	if (!d->FollowSystemColorScheme || d->SettingPalette)
+	{
+		return CStyleProcessor::eventFilter(Object, Event);
+	}
+
+	if (Event->type() == QEvent::ThemeChange)
+	{
+		d->onSystemColorSchemeChanged();
+	}
+	else if (Object == qApp && Event->type() == QEvent::ApplicationPaletteChange)
+	{
+		// A palette that has not been set by the style manager is the new
+		// palette of platforms without theme palette
+		d->PlatformPalette = qApp->palette();
+		d->PlatformPaletteCaptured = true;
+		d->onSystemColorSchemeChanged();
+	}
+#endif
+	return CStyleProcessor::eventFilter(Object, Event);
+}
+
+
+//============================================================================
+void CStyleManager::onStylesheetUpdateFinished(bool ApplyRequested)
+{
+	if (!ApplyRequested)
+	{
+		CStyleProcessor::onStylesheetUpdateFinished(ApplyRequested);
+		return;
+	}
+
+	applyToApplication();
+}
+
+
+//============================================================================
+void CStyleManager::applyToApplication()
+{
+	auto Palette = generateThemePalette();
+	bool PaletteChanged = (qApp->palette() != Palette);
+	auto Stylesheet = styleSheet();
+	bool StylesheetChanged = (qApp->styleSheet() != Stylesheet);
+	if (!PaletteChanged && !StylesheetChanged)
+	{
+		return;
+	}
+
+	// Suppress painting while palette and stylesheet change. The palette
+	// is set first, so that the following repolish already uses the new
+	// palette and each widget is repainted only once
+	QWidgetList SuspendedWidgets;
+	for (auto Widget : qApp->topLevelWidgets())
+	{
+		if (Widget->isVisible() && Widget->updatesEnabled())
+		{
+			Widget->setUpdatesEnabled(false);
+			SuspendedWidgets.append(Widget);
+		}
+	}
+
+	// The palette change events are delivered synchronously, so the time of
+	// setPalette() is the palette change event delivery time
+	QMap<QString, qint64> StageNs;
+	QElapsedTimer Timer;
+	Timer.start();
+	if (PaletteChanged)
+	{
+		d->setApplicationPalette(Palette);
+		StageNs.insert("palette", Timer.nsecsElapsed());
+	}
+
+	if (StylesheetChanged)
+	{
+		QElapsedTimer StylesheetTimer;
+		StylesheetTimer.start();
+		qApp->setStyleSheet(Stylesheet);
+		StageNs.insert("stylesheet", StylesheetTimer.nsecsElapsed());
+	}
+
+	for (auto Widget : SuspendedWidgets)
+	{
+		Widget->setUpdatesEnabled(true);
+	}
+	recordOperationMetrics("applyToApplication", Timer.nsecsElapsed(), StageNs);
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleManager.cpp
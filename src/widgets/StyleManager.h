@@ -0,0 +1,300 @@
+#ifndef StyleManagerH
+#define StyleManagerH
+//============================================================================
+/// \file   StyleManager.h
+/// \author Uwe Kindler
+/// \date   13.12.2021
+/// \brief  Declaration of CStyleManager class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleProcessor.h>
+
+class QIcon;
+class QColor;
+class QPalette;
+class QWidget;
+
+namespace acss
+{
+struct StyleManagerPrivate;
+
+/**
+ * Encapsulates all information about a single stylesheet based style.
+ * The style manager extends the headless CStyleProcessor with the functions
+ * that require a QApplication - the theme palette, the style fonts and icon
+ * and the application of the stylesheet.
+ */
+class CStyleManager : public CStyleProcessor
+{
+	Q_OBJECT
+private:
+	StyleManagerPrivate* d; ///< private data (pimpl)
+	friend struct StyleManagerPrivate;
+
+public:
+	/**
+	 * Default Constructor
+	 */
+	CStyleManager(QObject* parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CStyleManager();
+
+	/**
+	 * Returns the color for the given VariableId.
+	 * If VariableId is not a color variable, then this function returns an invalid
+	 * QColor.
+	 */
+	QColor themeColor(const QString& VariableId) const;
+
+	/**
+	 * Returns the icon for the current style or an empty icon if the style does
+	 * not provide an icon
+	 */
+	const QIcon& styleIcon() const;
+
+	/**
+	 * This function creates a palette with the theme colors of the currently
+	 * selected theme
+	 */
+	QPalette generateThemePalette() const;
+
+	/**
+	 * Creates a palette with the theme colors of the given scope
+	 * \see generateScopedStyle()
+	 */
+	QPalette generateScopedPalette(const QString& Scope) const;
+
+	/**
+	 * Adds the palette entries and the style icon to the memory footprint
+	 * of the CStyleProcessor
+	 */
+	virtual QJsonObject memoryFootprint() const override;
+
+	/**
+	 * Returns an icon for the generated SVG resource with the given name
+	 * (i.e. "primary/checkbox_checked.svg") with pre-rasterized pixmaps for
+	 * all rasterIconSizes() and all device pixel ratios of the connected
+	 * screens. A widget that is moved to a screen with a different device
+	 * pixel ratio picks up the ready pixmap instead of rendering the SVG
+	 * file again.
+	 * The icon sets are created on first request. They are dropped if the
+	 * device pixel ratios of the screens or the style resources changed.
+	 * Then resourceIconsChanged() is emitted and widgets should request their
+	 * icons again.
+	 * The rasterized pixmaps are stored in the artifactCache(), so switching
+	 * back to a recent theme does not render the SVG files again.
+	 */
+	QIcon resourceIcon(const QString& Name) const;
+
+	/**
+	 * Sets the logical icon sizes that resourceIcon() pre-rasterizes.
+	 * The default sizes are 16, 24 and 32 pixels.
+	 */
+	void setRasterIconSizes(const QList<int>& Sizes);
+
+	/**
+	 * Returns the logical icon sizes that resourceIcon() pre-rasterizes
+	 */
+	QList<int> rasterIconSizes() const;
+
+	/**
+	 * Returns the distinct device pixel ratios of the connected screens in
+	 * ascending order
+	 */
+	QList<qreal> screenDevicePixelRatios() const;
+
+	/**
+	 * Enables the rasterization of the stylesheet images. If enabled, the
+	 * generation pipeline writes a PNG file and @Nx variants for the device
+	 * pixel ratios of the connected screens next to each generated SVG
+	 * resource and the icon: URLs of the stylesheet refer to the PNG files.
+	 * Qt then picks the matching @Nx file instead of rendering the SVG
+	 * files in the GUI thread. If the device pixel ratios change, the
+	 * stylesheet is updated to write the missing variants.
+	 * The setting is used by the next stylesheet update. Disabled by default.
+	 */
+	void setRasterizeStylesheetImages(bool Rasterize);
+
+	/**
+	 * Returns true, if the stylesheet images are rasterized
+	 */
+	bool isRasterizingStylesheetImages() const;
+
+	/**
+	 * Sets the themes that are used for the light and the dark system color
+	 * scheme if isFollowingSystemColorScheme() is enabled
+	 */
+	void setSystemColorSchemeThemes(const QString& LightTheme, const QString& DarkTheme);
+
+	/**
+	 * Enables or disables the following of the system color scheme.
+	 * If enabled, the theme is switched to the light or dark theme set via
+	 * setSystemColorSchemeThemes() whenever the system color scheme changes.
+	 * The inactive theme is rendered ahead of time via generateScopedStyle()
+	 * into the scope "systemlight" or "systemdark", so that a switch takes
+	 * the generated stylesheet and resources from the artifactCache(). The
+	 * switch still writes the resources of the new theme to the output
+	 * folder and applies the palette and the stylesheet. The artifact cache
+	 * budget should be large enough for at least two themes.
+	 * The scope keeps one additional copy of the style resources in
+	 * scopeOutputPath() on disk. It is deleted if the theme becomes active
+	 * or the style changes.
+	 * With Qt 6.5 or newer, the color scheme is taken from QStyleHints. With
+	 * older Qt versions, the platformPalette() is evaluated for each theme
+	 * change event of the platform - a dark window color indicates a dark
+	 * color scheme. The theme palettes of the style manager are ignored.
+	 */
+	void setFollowSystemColorScheme(bool Follow);
+
+	/**
+	 * Returns true, if the system color scheme is followed
+	 */
+	bool isFollowingSystemColorScheme() const;
+
+	/**
+	 * Returns true, if the system uses a dark color scheme
+	 */
+	bool isSystemDarkMode() const;
+
+
+public slots:
+	/**
+	 * Call this function, if you would like to update the SVG files and the
+	 * application palette. The function calls generateResources() and
+	 * updateApplicationPaletteColors().
+	 * The functio will not update or create any stylesheet. After calling this
+	 * function, you can use the processStylesheetTemplate() function to
+	 * manually generate the style sheets from stylesheet template files.
+	 */
+	virtual bool processStyleTemplate() override;
+
+	/**
+	 * Generates the SVG resources and the stylesheet and then applies the
+	 * theme palette and the stylesheet to the application in a single step
+	 * via applyToApplication().
+	 * In contrast to updateStylesheet(), this function does not assign the
+	 * palette to the application before the stylesheet has been generated.
+	 * So all widgets are polished only once per theme switch. Slots
+	 * connected to stylesheetChanged() do not need to call
+	 * qApp->setStyleSheet() anymore if you use this function.
+	 */
+	bool updateApplicationStyle();
+
+	/**
+	 * Asynchronous variant of updateApplicationStyle().
+	 * The resources and the stylesheet are generated via
+	 * requestStylesheetUpdate() and applied to the application when the
+	 * generation finished. Use this function, if the theme is changed
+	 * interactively (i.e. from a theme list), so that stale theme switches
+	 * are cancelled.
+	 */
+	void requestApplicationStyleUpdate();
+
+	/**
+	 * Asynchronous cold start - loads the given style and theme via
+	 * openStyle() and applies the palette and the stylesheet to the
+	 * application as soon as the stylesheet is ready. The application
+	 * fonts of the style are registered in the GUI thread when the style
+	 * has been loaded.
+	 * \code
+	 * StyleManager->openApplicationStyle("qt_material", "dark_teal");
+	 * MainWindow.show();
+	 * \endcode
+	 */
+	void openApplicationStyle(const QString& Style, const QString& Theme = QString());
+
+	/**
+	 * Applies the given theme to the given window or widget subtree instead
+	 * of the whole application - i.e. a light theme for a print preview in
+	 * a dark application.
+	 * The palette and the stylesheet of the theme are generated via
+	 * generateScopedStyle() for the given scope and assigned to the widget.
+	 * Widgets that use the same scope share the generated style. If Scope
+	 * is empty, the theme name without the characters that are not allowed
+	 * in scope names is used as scope.
+	 * The widget stylesheet is applied on top of the application
+	 * stylesheet, so all rules of the scoped theme take precedence.
+	 */
+	bool applyScopedTheme(QWidget* Widget, const QString& Theme,
+		const QString& Scope = QString());
+
+	/**
+	 * Applies the light or the dark theme set via setSystemColorSchemeThemes()
+	 * depending on the current system color scheme. This function is called
+	 * automatically if isFollowingSystemColorScheme() is enabled.
+	 */
+	bool applySystemColorScheme();
+
+	/**
+	 * Assigns the theme palette and the current stylesheet to the application
+	 * object.
+	 * Painting of all visible top level windows is suspended while the
+	 * palette and the stylesheet are set, so that all widgets are repolished
+	 * and repainted only once. The palette or the stylesheet is only set, if
+	 * it differs from the one that is currently assigned to the application.
+	 */
+	void applyToApplication();
+
+	/**
+	 * Update the palette colors with the colors read from json file.
+	 * This function is called automatically if updateStylesheet() is called.
+	 * The function creates a palette with theme colors via generateThemePalette()
+	 * and then assigns the platte to the application object.
+	 */
+	void updateApplicationPaletteColors();
+
+protected:
+	/**
+	 * Detects theme and palette changes of the platform for the system color
+	 * scheme detection of Qt versions older than 6.5
+	 */
+	virtual bool eventFilter(QObject* Object, QEvent* Event) override;
+
+	/**
+	 * Returns the palette of the platform theme that decides about the
+	 * system color scheme if Qt does not provide a color scheme hint.
+	 * On platforms without theme palette, this is the application palette
+	 * before the style manager assigned its first theme palette or the last
+	 * application palette that has been set by others.
+	 */
+	virtual QPalette platformPalette() const;
+
+	/**
+	 * Parses the style palette and registers the style fonts
+	 */
+	virtual void onCurrentStyleLoaded() override;
+
+	/**
+	 * Updates the application palette
+	 */
+	virtual void onStylesheetUpdate() override;
+
+	/**
+	 * Applies the generated style to the application, if the update has
+	 * been requested via requestApplicationStyleUpdate()
+	 */
+	virtual void onStylesheetUpdateFinished(bool ApplyRequested) override;
+
+	/**
+	 * Returns the processor that rasterizes the stylesheet images if
+	 * setRasterizeStylesheetImages() is enabled
+	 */
+	virtual ResourceProcessor resourceProcessor() const override;
+
+signals:
+	/**
+	 * Emitted if the pixmaps of the resource icons have been rebuilt because
+	 * the screen configuration or the style resources changed
+	 */
+	void resourceIconsChanged();
+}; // class StyleManager
+}
+ // namespace namespace_name
+//-----------------------------------------------------------------------------
+#endif // StyleManagerH
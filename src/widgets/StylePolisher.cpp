@@ -0,0 +1,299 @@
+//============================================================================
+/// \file   StylePolisher.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStylePolisher class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StylePolisher.h>
+
+#include <QApplication>
+#include <QHash>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStyle>
+#include <QVector>
+#include <QWidget>
+
+namespace acss
+{
+/**
+ * Pending repolish of a widget
+ */
+struct PendingPolish
+{
+	QPointer<QWidget> Widget;
+	bool Recursive = false;
+};
+
+
+/**
+ * Private data class of CStylePolisher class (pimpl)
+ */
+struct StylePolisherPrivate
+{
+	CStylePolisher *_this;
+	QVector<QPointer<QWidget>> PendingWidgets;
+	QHash<QWidget*, PendingPolish> PendingPolishes;
+	bool PolishScheduled = false;
+	uint StylesheetKey = 0;
+	bool AncestorSelectorsValid = false;
+	QSet<QString> AncestorClasses;
+	QSet<QString> AncestorProperties;
+
+	/**
+	 * Private data constructor
+	 */
+	StylePolisherPrivate(CStylePolisher *_public) : _this(_public) {}
+
+	/**
+	 * Adds the widget to the list of pending widgets and schedules the
+	 * repolish if this did not happen yet
+	 */
+	void schedulePolish(QWidget* Widget, bool Recursive);
+
+	/**
+	 * Parses the application stylesheet for class selectors and attribute
+	 * selectors that are used in the ancestor part of a selector
+	 */
+	void updateAncestorSelectors();
+
+	/**
+	 * Returns true, if a change of the given class value affects the child
+	 * widgets
+	 */
+	bool affectsChildren(const QString& ClassValue);
+
+	/**
+	 * Returns true, if a change of the property with the given name affects
+	 * the child widgets
+	 */
+	bool propertyAffectsChildren(const QString& Name);
+
+	/**
+	 * Returns true, if the given widget will be repolished recursively.
+	 * The pending entry of a deleted widget does not match a new widget at
+	 * the same address.
+	 */
+	bool isPendingRecursive(QWidget* Widget) const;
+
+	/**
+	 * Returns true, if an ancestor of the given widget will be repolished
+	 * recursively
+	 */
+	bool hasPendingRecursiveAncestor(QWidget* Widget) const;
+};// struct StylePolisherPrivate
+
+
+//============================================================================
+void StylePolisherPrivate::schedulePolish(QWidget* Widget, bool Recursive)
+{
+	// An entry with a null pointer belongs to a deleted widget whose address
+	// has been reused
+	auto it = PendingPolishes.find(Widget);
+	if (it != PendingPolishes.end() && it->Widget)
+	{
+		it->Recursive = it->Recursive || Recursive;
+	}
+	else
+	{
+		PendingPolishes.insert(Widget, {Widget, Recursive});
+		PendingWidgets.append(Widget);
+	}
+
+	if (!PolishScheduled)
+	{
+		PolishScheduled = true;
+		QMetaObject::invokeMethod(_this, "polishPendingWidgets", Qt::QueuedConnection);
+	}
+}
+
+
+//============================================================================
+void StylePolisherPrivate::updateAncestorSelectors()
+{
+	auto Stylesheet = qApp->styleSheet();
+	auto Key = qHash(Stylesheet);
+	if (AncestorSelectorsValid && Key == StylesheetKey)
+	{
+		return;
+	}
+
+	StylesheetKey = Key;
+	AncestorSelectorsValid = true;
+	AncestorClasses.clear();
+	AncestorProperties.clear();
+	static const QRegularExpression CommentRegex("/\\*.*?\\*/",
+		QRegularExpression::DotMatchesEverythingOption);
+	static const QRegularExpression CombinatorRegex("\\s*>\\s*|\\s+");
+	static const QRegularExpression ClassRegex("\\.([\\w-]+)");
+	static const QRegularExpression PropertyRegex("\\[\\s*([\\w-]+)");
+	Stylesheet.remove(CommentRegex);
+	const auto Rules = Stylesheet.split('}');
+	for (const auto& Rule : Rules)
+	{
+		auto Selectors = Rule.left(Rule.indexOf('{')).split(',');
+		for (const auto& Selector : Selectors)
+		{
+			auto Compounds = Selector.trimmed().split(CombinatorRegex);
+			// The last compound selector matches the widget itself
+			for (int i = 0; i < Compounds.size() - 1; ++i)
+			{
+				auto Matches = ClassRegex.globalMatch(Compounds[i]);
+				while (Matches.hasNext())
+				{
+					AncestorClasses.insert(Matches.next().captured(1));
+				}
+
+				Matches = PropertyRegex.globalMatch(Compounds[i]);
+				while (Matches.hasNext())
+				{
+					AncestorProperties.insert(Matches.next().captured(1));
+				}
+			}
+		}
+	}
+}
+
+
+//============================================================================
+bool StylePolisherPrivate::affectsChildren(const QString& ClassValue)
+{
+	updateAncestorSelectors();
+	const auto Classes = ClassValue.split(' ');
+	for (const auto& Class : Classes)
+	{
+		if (AncestorClasses.contains(Class))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//============================================================================
+bool StylePolisherPrivate::propertyAffectsChildren(const QString& Name)
+{
+	updateAncestorSelectors();
+	return AncestorProperties.contains(Name);
+}
+
+
+//============================================================================
+bool StylePolisherPrivate::isPendingRecursive(QWidget* Widget) const
+{
+	auto it = PendingPolishes.find(Widget);
+	return it != PendingPolishes.end() && it->Widget == Widget && it->Recursive;
+}
+
+
+//============================================================================
+bool StylePolisherPrivate::hasPendingRecursiveAncestor(QWidget* Widget) const
+{
+	for (auto Parent = Widget->parentWidget(); Parent; Parent = Parent->parentWidget())
+	{
+		if (isPendingRecursive(Parent))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//============================================================================
+CStylePolisher::CStylePolisher(QObject* parent) :
+	QObject(parent),
+	d(new StylePolisherPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CStylePolisher::~CStylePolisher()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CStylePolisher::setStyleClass(QWidget* Widget, const QString& StyleClass)
+{
+	auto OldClass = Widget->property("class").toString();
+	if (OldClass == StyleClass)
+	{
+		return;
+	}
+
+	Widget->setProperty("class", StyleClass);
+	d->schedulePolish(Widget, d->affectsChildren(OldClass)
+		|| d->affectsChildren(StyleClass));
+}
+
+
+//============================================================================
+void CStylePolisher::setStyleProperty(QWidget* Widget, const char* Name,
+	const QVariant& Value)
+{
+	if (Widget->property(Name) == Value)
+	{
+		return;
+	}
+
+	Widget->setProperty(Name, Value);
+	d->schedulePolish(Widget, d->propertyAffectsChildren(QString::fromLatin1(Name)));
+}
+
+
+//============================================================================
+void CStylePolisher::repolish(QWidget* Widget, bool Recursive)
+{
+	auto Style = Widget->style();
+	Style->unpolish(Widget);
+	Style->polish(Widget);
+	Widget->update();
+	if (!Recursive)
+	{
+		return;
+	}
+
+	const auto Children = Widget->findChildren<QWidget*>();
+	for (auto Child : Children)
+	{
+		repolish(Child, false);
+	}
+}
+
+
+//============================================================================
+void CStylePolisher::polishPendingWidgets()
+{
+	d->PolishScheduled = false;
+	const auto PendingWidgets = d->PendingWidgets;
+	d->PendingWidgets.clear();
+	for (const auto& Widget : PendingWidgets)
+	{
+		// Skip deleted widgets and widgets that are covered by the recursive
+		// repolish of an ancestor
+		if (!Widget || d->hasPendingRecursiveAncestor(Widget))
+		{
+			continue;
+		}
+
+		repolish(Widget, d->isPendingRecursive(Widget));
+	}
+	d->PendingPolishes.clear();
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StylePolisher.cpp
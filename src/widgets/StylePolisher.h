@@ -0,0 +1,94 @@
+#ifndef StylePolisherH
+#define StylePolisherH
+//============================================================================
+/// \file   StylePolisher.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStylePolisher class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QString>
+#include <QVariant>
+
+class QWidget;
+
+namespace acss
+{
+struct StylePolisherPrivate;
+
+/**
+ * Changes style classes and dynamic properties of widgets and repolishes
+ * only the affected widgets.
+ * The stylesheet template uses class selectors like .danger, .warning or
+ * .success. Qt matches these selectors against the dynamic "class" property
+ * of a widget. Changing this property requires a repolish of the widget.
+ * This class collects all changes that are requested during one event loop
+ * iteration and repolishes each affected widget only once when control
+ * returns to the event loop. The children of a widget are only repolished,
+ * if the old or the new class is used in an ancestor part of a selector
+ * (i.e. .danger QLabel) in the application stylesheet. The same applies to
+ * dynamic properties in attribute selectors (i.e. QFrame[state="error"]
+ * QLabel).
+ * \code
+ * auto Polisher = new CStylePolisher(this);
+ * Polisher->setStyleClass(ui->StatusLabel, "danger");
+ * \endcode
+ */
+class CStylePolisher : public QObject
+{
+	Q_OBJECT
+private:
+	StylePolisherPrivate* d; ///< private data (pimpl)
+	friend struct StylePolisherPrivate;
+
+public:
+	/**
+	 * Default Constructor
+	 */
+	CStylePolisher(QObject* parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CStylePolisher();
+
+	/**
+	 * Sets the style class of the given widget (the dynamic property "class")
+	 * and schedules a repolish of the widget.
+	 * Nothing happens, if the widget already has the given class.
+	 */
+	void setStyleClass(QWidget* Widget, const QString& StyleClass);
+
+	/**
+	 * Sets the dynamic property with the given name and schedules a repolish
+	 * of the widget. Use this function for properties that are used in
+	 * attribute selectors like QLabel[state="error"]. The child widgets are
+	 * repolished, too, if the property is used in the ancestor part of a
+	 * selector.
+	 * Nothing happens, if the property already has the given value.
+	 */
+	void setStyleProperty(QWidget* Widget, const char* Name, const QVariant& Value);
+
+	/**
+	 * Immediately repolishes the given widget. If Recursive is true, then
+	 * all child widgets are repolished, too.
+	 */
+	static void repolish(QWidget* Widget, bool Recursive = false);
+
+public slots:
+	/**
+	 * Repolishes all widgets with pending changes.
+	 * This function is called automatically when control returns to the
+	 * event loop. You can call it explicitely, if you need the changes
+	 * to become visible immediately.
+	 */
+	void polishPendingWidgets();
+}; // class CStylePolisher
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StylePolisherH
@@ -0,0 +1,371 @@
+//============================================================================
+/// \file   StyleProfiler.cpp
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Implementation of CStyleProfiler class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <StyleProfiler.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QVector>
+
+namespace acss
+{
+/**
+ * Aggregated measurement values for one widget class or one named widget
+ */
+struct ProfileEntry
+{
+	qint64 PolishCount = 0;
+	qint64 PolishNs = 0;
+	qint64 MaxPolishNs = 0;
+	qint64 PaintCount = 0;
+	qint64 PaintNs = 0;
+	qint64 MaxPaintNs = 0;
+
+	void add(bool Paint, qint64 Ns)
+	{
+		if (Paint)
+		{
+			PaintCount++;
+			PaintNs += Ns;
+			MaxPaintNs = std::max(MaxPaintNs, Ns);
+		}
+		else
+		{
+			PolishCount++;
+			PolishNs += Ns;
+			MaxPolishNs = std::max(MaxPolishNs, Ns);
+		}
+	}
+
+	qint64 totalNs() const
+	{
+		return PolishNs + PaintNs;
+	}
+};
+
+using ProfileEntryMap = QHash<QString, ProfileEntry>;
+
+
+/**
+ * One running measurement of a polish or paint event
+ */
+struct ProfileSpan
+{
+	bool Paint = false;
+	qint64 StartNs = 0;
+	qint64 NestedNs = 0;
+	QString Class;
+	QString Object;
+};
+
+
+/**
+ * Private data class of CStyleProfiler class (pimpl)
+ */
+struct StyleProfilerPrivate
+{
+	CStyleProfiler *_this;
+	bool Running = false;
+	ProfileEntryMap Classes;
+	ProfileEntryMap Objects;
+	QElapsedTimer Clock;
+	QVector<ProfileSpan> Spans;
+	QEvent* DeliveredEvent = nullptr;
+
+	/**
+	 * Private data constructor
+	 */
+	StyleProfilerPrivate(CStyleProfiler *_public) : _this(_public) {}
+
+	/**
+	 * Starts the measurement of a polish or paint event of the given widget
+	 */
+	void openSpan(QObject* Widget, bool Paint);
+
+	/**
+	 * Ends the innermost measurement and adds its exclusive time to the
+	 * results
+	 */
+	void closeSpan();
+
+	/**
+	 * Delivers the given polish or paint event to the widget and measures
+	 * the time until the delivery returns
+	 */
+	void deliverMeasured(QObject* Widget, QEvent* Event, bool Paint);
+
+	/**
+	 * Returns the entries of the given map as JSON array, sorted by total time
+	 */
+	static QJsonArray toJson(const ProfileEntryMap& Entries);
+
+	/**
+	 * Returns the keys of the given map sorted by total time
+	 */
+	static QStringList sortedKeys(const ProfileEntryMap& Entries);
+};// struct StyleProfilerPrivate
+
+
+//============================================================================
+void StyleProfilerPrivate::openSpan(QObject* Widget, bool Paint)
+{
+	ProfileSpan Span;
+	Span.Paint = Paint;
+	Span.Class = QString::fromLatin1(Widget->metaObject()->className());
+	Span.Object = Widget->objectName();
+	Span.StartNs = Clock.nsecsElapsed();
+	Spans.append(Span);
+}
+
+
+//============================================================================
+void StyleProfilerPrivate::closeSpan()
+{
+	if (Spans.isEmpty())
+	{
+		return;
+	}
+
+	auto Span = Spans.takeLast();
+	auto ElapsedNs = Clock.nsecsElapsed() - Span.StartNs;
+	// The time of nested spans is accounted to the nested widgets only
+	if (!Spans.isEmpty())
+	{
+		Spans.last().NestedNs += ElapsedNs;
+	}
+	ElapsedNs -= Span.NestedNs;
+	Classes[Span.Class].add(Span.Paint, ElapsedNs);
+	if (!Span.Object.isEmpty())
+	{
+		Objects[Span.Class + "#" + Span.Object].add(Span.Paint, ElapsedNs);
+	}
+}
+
+
+//============================================================================
+void StyleProfilerPrivate::deliverMeasured(QObject* Widget, QEvent* Event, bool Paint)
+{
+	// The event passes the profiler filter a second time during the
+	// delivery. It is marked, so that the filter lets it through
+	auto PreviousEvent = DeliveredEvent;
+	DeliveredEvent = Event;
+	openSpan(Widget, Paint);
+	qApp->notify(Widget, Event);
+	closeSpan();
+	DeliveredEvent = PreviousEvent;
+}
+
+
+//============================================================================
+QStringList StyleProfilerPrivate::sortedKeys(const ProfileEntryMap& Entries)
+{
+	auto Keys = Entries.keys();
+	std::sort(Keys.begin(), Keys.end(), [&Entries](const QString& a, const QString& b)
+	{
+		return Entries.value(a).totalNs() > Entries.value(b).totalNs();
+	});
+	return Keys;
+}
+
+
+//============================================================================
+QJsonArray StyleProfilerPrivate::toJson(const ProfileEntryMap& Entries)
+{
+	static const double NsPerMs = 1000000.0;
+	QJsonArray jEntries;
+	for (const auto& Key : sortedKeys(Entries))
+	{
+		const auto& Entry = Entries[Key];
+		QJsonObject jEntry;
+		jEntry.insert("name", Key);
+		jEntry.insert("polish_count", double(Entry.PolishCount));
+		jEntry.insert("polish_ms", Entry.PolishNs / NsPerMs);
+		jEntry.insert("polish_max_ms", Entry.MaxPolishNs / NsPerMs);
+		jEntry.insert("paint_count", double(Entry.PaintCount));
+		jEntry.insert("paint_ms", Entry.PaintNs / NsPerMs);
+		jEntry.insert("paint_max_ms", Entry.MaxPaintNs / NsPerMs);
+		jEntry.insert("paint_avg_ms", Entry.PaintCount
+			? Entry.PaintNs / NsPerMs / Entry.PaintCount : 0.0);
+		jEntries.append(jEntry);
+	}
+	return jEntries;
+}
+
+
+//============================================================================
+CStyleProfiler::CStyleProfiler(QObject* parent) :
+	QObject(parent),
+	d(new StyleProfilerPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CStyleProfiler::~CStyleProfiler()
+{
+	stop();
+	delete d;
+}
+
+
+//============================================================================
+void CStyleProfiler::start()
+{
+	if (d->Running)
+	{
+		return;
+	}
+
+	d->Clock.start();
+	qApp->installEventFilter(this);
+	d->Running = true;
+}
+
+
+//============================================================================
+void CStyleProfiler::stop()
+{
+	if (!d->Running)
+	{
+		return;
+	}
+
+	qApp->removeEventFilter(this);
+	d->Running = false;
+}
+
+
+//============================================================================
+bool CStyleProfiler::isRunning() const
+{
+	return d->Running;
+}
+
+
+//============================================================================
+void CStyleProfiler::reset()
+{
+	d->Classes.clear();
+	d->Objects.clear();
+}
+
+
+//============================================================================
+bool CStyleProfiler::eventFilter(QObject* Watched, QEvent* Event)
+{
+	// An event filter has no hook that is called after the event has been
+	// handled. So the profiler delivers polish and paint events itself via
+	// QCoreApplication::notify() and measures until the delivery returns.
+	// Events that are sent while a widget handles its polish or paint event
+	// (i.e. palette and font changes) are accounted to this widget.
+	if (Event == d->DeliveredEvent || !Watched->isWidgetType())
+	{
+		return false;
+	}
+
+	switch (Event->type())
+	{
+	case QEvent::Polish:
+	case QEvent::StyleChange:
+		d->deliverMeasured(Watched, Event, false);
+		return true;
+
+	case QEvent::Paint:
+		d->deliverMeasured(Watched, Event, true);
+		return true;
+
+	default:
+		break;
+	}
+	return false;
+}
+
+
+//============================================================================
+QJsonObject CStyleProfiler::results() const
+{
+	QJsonObject jResults;
+	auto Stylesheet = qApp->styleSheet();
+	jResults.insert("stylesheet_size", Stylesheet.size());
+	jResults.insert("stylesheet_hash", QString::number(qHash(Stylesheet), 16));
+	jResults.insert("classes", d->toJson(d->Classes));
+	jResults.insert("objects", d->toJson(d->Objects));
+	return jResults;
+}
+
+
+//============================================================================
+QString CStyleProfiler::textReport(int MaxRows) const
+{
+	static const double NsPerMs = 1000000.0;
+	QString Report;
+	QTextStream Stream(&Report);
+	auto writeTable = [&](const QString& Title, const ProfileEntryMap& Entries)
+	{
+		Stream << Title << "\n";
+		Stream << QString("%1%2%3%4%5%6\n").arg("Name", -40).arg("Polish", 10)
+			.arg("Polish ms", 12).arg("Paint", 10).arg("Paint ms", 12).arg("ms/Paint", 12);
+		auto Keys = d->sortedKeys(Entries);
+		for (int i = 0; i < Keys.size() && i < MaxRows; ++i)
+		{
+			const auto& Entry = Entries[Keys[i]];
+			double PaintAvgMs = Entry.PaintCount
+				? Entry.PaintNs / NsPerMs / Entry.PaintCount : 0.0;
+			Stream << QString("%1%2%3%4%5%6\n").arg(Keys[i], -40)
+				.arg(Entry.PolishCount, 10).arg(Entry.PolishNs / NsPerMs, 12, 'f', 3)
+				.arg(Entry.PaintCount, 10).arg(Entry.PaintNs / NsPerMs, 12, 'f', 3)
+				.arg(PaintAvgMs, 12, 'f', 3);
+		}
+		Stream << "\n";
+	};
+
+	writeTable("Widget classes", d->Classes);
+	writeTable("Named widgets", d->Objects);
+	Stream.flush();
+	return Report;
+}
+
+
+//============================================================================
+bool CStyleProfiler::exportReport(const QString& FileName) const
+{
+	QFile ReportFile(FileName);
+	if (!ReportFile.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	if (QFileInfo(FileName).suffix().toLower() == "json")
+	{
+		ReportFile.write(QJsonDocument(results()).toJson());
+	}
+	else
+	{
+		ReportFile.write(textReport(std::numeric_limits<int>::max()).toUtf8());
+	}
+	return true;
+}
+
+} // namespace acss
+
+//---------------------------------------------------------------------------
+// EOF StyleProfiler.cpp
@@ -0,0 +1,114 @@
+#ifndef StyleProfilerH
+#define StyleProfilerH
+//============================================================================
+/// \file   StyleProfiler.h
+/// \author Uwe Kindler
+/// \date   18.10.2026
+/// \brief  Declaration of CStyleProfiler class
+//============================================================================
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+#include <QString>
+
+class QJsonObject;
+
+namespace acss
+{
+struct StyleProfilerPrivate;
+
+/**
+ * Opt-in profiler that measures the time spent for polishing and painting
+ * of widgets under the current application stylesheet.
+ * The profiler installs an application wide event filter and measures the
+ * handling of polish (QEvent::Polish and QEvent::StyleChange) and paint
+ * events. The times are aggregated per widget class and per object name
+ * until reset() is called. So you can run a complete session and export
+ * the report at the end to see, which widget classes and therefore which
+ * stylesheet rules are expensive.
+ * \code
+ * auto Profiler = new CStyleProfiler(this);
+ * Profiler->start();
+ * // ... use the application
+ * Profiler->exportReport("style_profile.json");
+ * \endcode
+ * The measured times are exclusive times - the time spent in nested events
+ * of other widgets is not accounted to the outer widget.
+ * To measure until the handling of an event returns, the profiler delivers
+ * polish and paint events itself via QCoreApplication::notify() and filters
+ * out the original delivery. Application event filters that have been
+ * installed after start() therefore see these events twice.
+ */
+class CStyleProfiler : public QObject
+{
+	Q_OBJECT
+private:
+	StyleProfilerPrivate* d; ///< private data (pimpl)
+	friend struct StyleProfilerPrivate;
+
+public:
+	/**
+	 * Default Constructor
+	 */
+	CStyleProfiler(QObject* parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CStyleProfiler();
+
+	/**
+	 * Returns true, if the profiler is running
+	 */
+	bool isRunning() const;
+
+	/**
+	 * Returns the aggregated results as JSON object.
+	 * The object contains the arrays "classes" and "objects" with one entry
+	 * per widget class and per named widget. Each entry contains the number
+	 * of polish and paint events and the total and maximum times in
+	 * milliseconds.
+	 */
+	QJsonObject results() const;
+
+	/**
+	 * Returns a human readable report with the MaxRows most expensive widget
+	 * classes and named widgets, sorted by the sum of polish and paint time
+	 */
+	QString textReport(int MaxRows = 20) const;
+
+	/**
+	 * Exports the report into the given file. If the file name has the suffix
+	 * .json, then the JSON results() are exported, otherwise the textReport()
+	 * is written.
+	 * Returns false, if writing the file failed.
+	 */
+	bool exportReport(const QString& FileName) const;
+
+	/**
+	 * Filters and measures the polish and paint events of all widgets
+	 */
+	virtual bool eventFilter(QObject* Watched, QEvent* Event) override;
+
+public slots:
+	/**
+	 * Installs the event filter and starts the measurement
+	 */
+	void start();
+
+	/**
+	 * Removes the event filter. The aggregated results are kept.
+	 */
+	void stop();
+
+	/**
+	 * Clears all aggregated results
+	 */
+	void reset();
+}; // class CStyleProfiler
+}
+ // namespace acss
+//-----------------------------------------------------------------------------
+#endif // StyleProfilerH
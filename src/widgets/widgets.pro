@@ -0,0 +1,28 @@
+# Adapter library for QtWidgets applications. It applies the palette, the
+# fonts and the stylesheet of the core library to the application.
+include(../src.pri)
+
+TARGET = $$qtLibraryTarget(qtadvancedcss)
+QT += core gui widgets
+# QPlatformTheme for the system color scheme detection without Qt 6.5
+QT += gui-private
+
+INCLUDEPATH += ../core
+DEPENDPATH += ../core
+LIBS += -L$${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core
+include(../../acss.pri)
+
+HEADERS += \
+	PaletteSchema.h \
+	StyleManager.h \
+	StylePolisher.h \
+	StyleProfiler.h
+
+
+SOURCES += \
+	StyleManager.cpp \
+	StylePolisher.cpp \
+	StyleProfiler.cpp
+
+headers.files=$$HEADERS
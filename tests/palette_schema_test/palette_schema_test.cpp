@@ -0,0 +1,56 @@
+#include <PaletteSchema.h>
+#include <QMetaEnum>
+#include <QtTest>
+
+using namespace acss;
+
+/**
+ * Tests of the palette lookup tables of the style JSON schema
+ */
+class CPaletteSchemaTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void colorRolesRoundTrip()
+	{
+		auto MetaEnum = QPalette::staticMetaObject.enumerator(
+			QPalette::staticMetaObject.indexOfEnumerator("ColorRole"));
+		QVERIFY(MetaEnum.isValid());
+		for (int i = 0; i < QPalette::NColorRoles; ++i)
+		{
+			auto Role = QPalette::ColorRole(i);
+			auto Name = ColorRoles.name(Role);
+			QVERIFY2(Name, MetaEnum.valueToKey(i));
+			QCOMPARE(QString(Name), QString(MetaEnum.valueToKey(i)));
+			QCOMPARE(ColorRoles.value(QString(Name), QPalette::NColorRoles), Role);
+		}
+		QCOMPARE(ColorRoles.value("ButtonText", QPalette::NoRole), QPalette::ButtonText);
+	}
+
+	void colorGroupsRoundTrip()
+	{
+		for (auto Group : {QPalette::Active, QPalette::Disabled, QPalette::Inactive})
+		{
+			auto Name = ColorGroups.name(Group);
+			QVERIFY(Name);
+			QCOMPARE(ColorGroups.value(QString(Name), QPalette::NColorGroups), Group);
+		}
+		QCOMPARE(ColorGroups.value("disabled", QPalette::Active), QPalette::Disabled);
+	}
+
+	void unknownNamesReturnDefault()
+	{
+		for (auto Name : {QString("ButtonTextd"), QString("buttontext"), QString(),
+			QString("ButtonéText"), QString::fromUtf8("W\xc3\xafndow"),
+			QString("Window中")})
+		{
+			QCOMPARE(ColorRoles.value(Name, QPalette::NoRole), QPalette::NoRole);
+			QCOMPARE(ColorGroups.value(Name, QPalette::Current), QPalette::Current);
+		}
+		QCOMPARE(ColorGroups.value("Active", QPalette::Current), QPalette::Current);
+	}
+};
+
+QTEST_APPLESS_MAIN(CPaletteSchemaTest)
+
+#include "palette_schema_test.moc"
@@ -0,0 +1,18 @@
+QT += core gui testlib
+
+
+TARGET = palette_schema_test
+DESTDIR = $${OUT_PWD}/../../lib
+TEMPLATE = app
+
+CONFIG += c++14
+CONFIG += console
+CONFIG += testcase
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += palette_schema_test.cpp
+
+# The schema tables are header only, so no library is linked
+INCLUDEPATH += ../../src/core ../../src/widgets
+DEPENDPATH += ../../src/core ../../src/widgets
@@ -0,0 +1,140 @@
+#include <StyleCache.h>
+#include <QDir>
+#include <QFile>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace acss;
+
+/**
+ * Tests of the eviction and the spill directory of CStyleCache
+ */
+class CStyleCacheTest : public QObject
+{
+	Q_OBJECT
+private:
+	/**
+	 * Returns the number of spill files of the given kind in Dir
+	 */
+	static int spillFileCount(const QString& Dir, CStyleCache::eArtifactKind Kind)
+	{
+		return QDir(Dir + "/" + CStyleCache::kindName(Kind)).entryList(QDir::Files).size();
+	}
+
+	/**
+	 * Returns the value of the counter Name of the given kind
+	 */
+	static int stat(const CStyleCache& Cache, CStyleCache::eArtifactKind Kind,
+		const QString& Name)
+	{
+		auto jKind = Cache.stats().value(CStyleCache::kindName(Kind)).toObject();
+		return jKind.value(Name).toInt();
+	}
+
+private slots:
+	void evictsLeastRecentlyUsed()
+	{
+		CStyleCache Cache;
+		Cache.setBudget(200);
+		Cache.insert(CStyleCache::StylesheetArtifact, "a", QByteArray(100, 'a'));
+		Cache.insert(CStyleCache::StylesheetArtifact, "b", QByteArray(100, 'b'));
+		QByteArray Data;
+		// The access makes "b" the least recently used artifact
+		QVERIFY(Cache.find(CStyleCache::StylesheetArtifact, "a", Data));
+		Cache.insert(CStyleCache::StylesheetArtifact, "c", QByteArray(100, 'c'));
+
+		QCOMPARE(Cache.size(), qint64(200));
+		QVERIFY(Cache.find(CStyleCache::StylesheetArtifact, "a", Data));
+		QVERIFY(Cache.find(CStyleCache::StylesheetArtifact, "c", Data));
+		QVERIFY(!Cache.find(CStyleCache::StylesheetArtifact, "b", Data));
+		QCOMPARE(stat(Cache, CStyleCache::StylesheetArtifact, "evictions"), 1);
+		QCOMPARE(stat(Cache, CStyleCache::StylesheetArtifact, "misses"), 1);
+	}
+
+	void enforcesKindBudget()
+	{
+		CStyleCache Cache;
+		Cache.setKindBudget(CStyleCache::ResourceArtifact, 100);
+		Cache.insert(CStyleCache::ResourceArtifact, "a", QByteArray(60, 'a'));
+		Cache.insert(CStyleCache::ResourceArtifact, "b", QByteArray(60, 'b'));
+		Cache.insert(CStyleCache::StylesheetArtifact, "c", QByteArray(60, 'c'));
+
+		QCOMPARE(Cache.size(CStyleCache::ResourceArtifact), qint64(60));
+		QCOMPARE(Cache.size(CStyleCache::StylesheetArtifact), qint64(60));
+		QByteArray Data;
+		QVERIFY(!Cache.find(CStyleCache::ResourceArtifact, "a", Data));
+		QVERIFY(Cache.find(CStyleCache::ResourceArtifact, "b", Data));
+	}
+
+	void spillRoundTrip()
+	{
+		QTemporaryDir SpillDir;
+		CStyleCache Cache;
+		Cache.setSpillDirPath(SpillDir.path());
+		Cache.setBudget(100);
+		Cache.insert(CStyleCache::RasterArtifact, "a", QByteArray(100, 'a'));
+		Cache.insert(CStyleCache::RasterArtifact, "b", QByteArray(100, 'b'));
+		QCOMPARE(spillFileCount(SpillDir.path(), CStyleCache::RasterArtifact), 1);
+		QCOMPARE(stat(Cache, CStyleCache::RasterArtifact, "spills"), 1);
+
+		// The spilled artifact is reloaded and evicts "b" into the spill
+		// directory
+		QByteArray Data;
+		QVERIFY(Cache.find(CStyleCache::RasterArtifact, "a", Data));
+		QCOMPARE(Data, QByteArray(100, 'a'));
+		QCOMPARE(stat(Cache, CStyleCache::RasterArtifact, "spill_hits"), 1);
+		QVERIFY(Cache.find(CStyleCache::RasterArtifact, "b", Data));
+		QCOMPARE(Data, QByteArray(100, 'b'));
+		QCOMPARE(stat(Cache, CStyleCache::RasterArtifact, "spill_hits"), 2);
+		QCOMPARE(spillFileCount(SpillDir.path(), CStyleCache::RasterArtifact), 2);
+	}
+
+	void replacedArtifactDropsSpillFile()
+	{
+		QTemporaryDir SpillDir;
+		CStyleCache Cache;
+		Cache.setSpillDirPath(SpillDir.path());
+		Cache.setBudget(100);
+		Cache.insert(CStyleCache::StylesheetArtifact, "a", QByteArray(100, 'a'));
+		Cache.insert(CStyleCache::StylesheetArtifact, "b", QByteArray(100, 'b'));
+		QCOMPARE(spillFileCount(SpillDir.path(), CStyleCache::StylesheetArtifact), 1);
+
+		// Replacing "a" evicts "b", the old spill file of "a" is deleted
+		Cache.insert(CStyleCache::StylesheetArtifact, "a", QByteArray(100, 'x'));
+		Cache.clear();
+		QByteArray Data;
+		QVERIFY(Cache.find(CStyleCache::StylesheetArtifact, "b", Data));
+		QVERIFY(!Cache.find(CStyleCache::StylesheetArtifact, "a", Data));
+	}
+
+	void removesSpillFiles()
+	{
+		QTemporaryDir SpillDir;
+		QFile OtherFile(SpillDir.path() + "/other.txt");
+		QVERIFY(OtherFile.open(QIODevice::WriteOnly));
+		OtherFile.close();
+
+		// Stale spill files of a previous cache are removed
+		QVERIFY(QDir().mkpath(SpillDir.path() + "/stylesheet"));
+		QFile StaleFile(SpillDir.path() + "/stylesheet/stale");
+		QVERIFY(StaleFile.open(QIODevice::WriteOnly));
+		StaleFile.close();
+
+		{
+			CStyleCache Cache;
+			Cache.setSpillDirPath(SpillDir.path());
+			QVERIFY(!StaleFile.exists());
+			Cache.setBudget(0);
+			Cache.insert(CStyleCache::StylesheetArtifact, "a", QByteArray(10, 'a'));
+			QCOMPARE(spillFileCount(SpillDir.path(), CStyleCache::StylesheetArtifact), 1);
+		}
+
+		QVERIFY(!QDir(SpillDir.path() + "/stylesheet").exists());
+		QVERIFY(OtherFile.exists());
+	}
+};
+
+QTEST_APPLESS_MAIN(CStyleCacheTest)
+
+#include "style_cache_test.moc"
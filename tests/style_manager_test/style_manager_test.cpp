@@ -0,0 +1,203 @@
+#include <StyleManager.h>
+#include <QApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QPalette>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QWidget>
+#include <QtTest>
+
+#include <qpa/qwindowsysteminterface.h>
+
+using namespace acss;
+
+#define _STR(x) #x
+#define STRINGIFY(x)  _STR(x)
+
+/**
+ * Copies the directory Source recursively into Target
+ */
+static bool copyDirectory(const QString& Source, const QString& Target)
+{
+	QDir SourceDir(Source);
+	QDirIterator it(Source, QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext())
+	{
+		auto FilePath = it.next();
+		auto TargetPath = Target + "/" + SourceDir.relativeFilePath(FilePath);
+		if (!QDir().mkpath(QFileInfo(TargetPath).absolutePath())
+		 || !QFile::copy(FilePath, TargetPath))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Returns a palette of the platform with the given window color
+ */
+static QPalette paletteWithWindowColor(const QColor& WindowColor)
+{
+	QPalette Palette = qApp->style()->standardPalette();
+	Palette.setColor(QPalette::Window, WindowColor);
+	return Palette;
+}
+
+
+/**
+ * Returns the number of operationFinished() signals for the given operation
+ */
+static int operationCount(const QSignalSpy& Spy, const QString& Operation)
+{
+	int Count = 0;
+	for (const auto& Arguments : Spy)
+	{
+		if (Arguments.at(0).toString() == Operation)
+		{
+			Count++;
+		}
+	}
+	return Count;
+}
+
+
+/**
+ * Style manager with a platform palette that is controlled by the test
+ */
+class CTestStyleManager : public CStyleManager
+{
+public:
+	QPalette PlatformPalette = paletteWithWindowColor(Qt::white);
+
+protected:
+	virtual QPalette platformPalette() const override
+	{
+		return PlatformPalette;
+	}
+};
+
+
+/**
+ * Tests of the CStyleManager functions that require a QApplication
+ */
+class CStyleManagerTest : public QObject
+{
+	Q_OBJECT
+private:
+	QTemporaryDir StylesDir;
+	QTemporaryDir OutputDir;
+	CTestStyleManager* StyleManager = nullptr;
+	QWidget* Window = nullptr;
+
+	/**
+	 * Changes the platform palette and delivers the theme change of the
+	 * platform like a switch of the color scheme of the operating system
+	 */
+	void switchPlatformTheme(const QColor& WindowColor)
+	{
+		StyleManager->PlatformPalette = paletteWithWindowColor(WindowColor);
+		QWindowSystemInterface::handleThemeChange<
+			QWindowSystemInterface::SynchronousDelivery>(Window->windowHandle());
+	}
+
+private slots:
+	void initTestCase()
+	{
+		// The window color of the theme palettes follows the theme, so the
+		// dark theme palette has a dark window color like a dark platform
+		auto StylePath = StylesDir.path() + "/qt_material";
+		QVERIFY(copyDirectory(QString(STRINGIFY(STYLES_DIR)) + "/qt_material", StylePath));
+		QFile JsonFile(StylePath + "/material.json");
+		QVERIFY(JsonFile.open(QIODevice::ReadOnly));
+		auto Json = JsonFile.readAll();
+		JsonFile.close();
+		Json.replace("\"Window\" : \"\"", "\"Window\" : \"secondaryColor\"");
+		QVERIFY(JsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+		JsonFile.write(Json);
+	}
+
+	void init()
+	{
+#if QT_VERSION >= 0x060500
+		QSKIP("The color scheme is taken from QStyleHints");
+#endif
+		Window = new QWidget();
+		Window->show();
+		QVERIFY(QTest::qWaitForWindowExposed(Window));
+		StyleManager = new CTestStyleManager();
+		StyleManager->setStylesDirPath(StylesDir.path());
+		StyleManager->setOutputDirPath(OutputDir.path());
+		QVERIFY(StyleManager->setCurrentStyle("qt_material"));
+		QVERIFY(StyleManager->setCurrentTheme("light_blue"));
+		StyleManager->setSystemColorSchemeThemes("light_blue", "dark_teal");
+	}
+
+	void cleanup()
+	{
+		delete StyleManager;
+		StyleManager = nullptr;
+		delete Window;
+		Window = nullptr;
+	}
+
+	void themePaletteIsNotSystemColorScheme()
+	{
+		StyleManager->setFollowSystemColorScheme(true);
+		QVERIFY(!StyleManager->isSystemDarkMode());
+
+		// The dark theme palette of the style manager must not be taken
+		// as the palette of the platform
+		QVERIFY(StyleManager->setCurrentTheme("dark_teal"));
+		QVERIFY(StyleManager->updateApplicationStyle());
+		QVERIFY(qApp->palette().color(QPalette::Window).lightness() < 128);
+		QVERIFY(!StyleManager->isSystemDarkMode());
+	}
+
+	void followsPlatformTheme()
+	{
+		StyleManager->setFollowSystemColorScheme(true);
+		QCOMPARE(StyleManager->currentTheme(), QString("light_blue"));
+
+		switchPlatformTheme(QColor(32, 32, 32));
+		QVERIFY(StyleManager->isSystemDarkMode());
+		QCOMPARE(StyleManager->currentTheme(), QString("dark_teal"));
+
+		switchPlatformTheme(Qt::white);
+		QVERIFY(!StyleManager->isSystemDarkMode());
+		QCOMPARE(StyleManager->currentTheme(), QString("light_blue"));
+	}
+
+	void recordsSystemColorSchemeSwitchOnce()
+	{
+		StyleManager->setFollowSystemColorScheme(true);
+		QSignalSpy Spy(StyleManager, &CStyleProcessor::operationFinished);
+		switchPlatformTheme(QColor(32, 32, 32));
+		QCOMPARE(StyleManager->currentTheme(), QString("dark_teal"));
+		QCOMPARE(operationCount(Spy, "applySystemColorScheme"), 1);
+		QCOMPARE(operationCount(Spy, "applyToApplication"), 0);
+
+		auto Stages = StyleManager->metrics().value("stages").toObject();
+		QVERIFY(Stages.contains("applySystemColorScheme/applyToApplication"));
+		QVERIFY(!Stages.contains("applyToApplication"));
+	}
+};
+
+
+int main(int argc, char* argv[])
+{
+	// The tests do not need a display
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+	{
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+	QApplication App(argc, argv);
+	CStyleManagerTest Test;
+	return QTest::qExec(&Test, argc, argv);
+}
+
+#include "style_manager_test.moc"
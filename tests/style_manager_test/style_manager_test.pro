@@ -0,0 +1,30 @@
+ACSS_OUT_ROOT = $${OUT_PWD}/../..
+
+QT += core gui gui-private widgets testlib
+
+
+TARGET = style_manager_test
+DESTDIR = $${ACSS_OUT_ROOT}/lib
+TEMPLATE = app
+
+CONFIG += c++14
+CONFIG += console
+CONFIG += testcase
+
+acssBuildStatic {
+    DEFINES += ACSS_STATIC
+}
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += style_manager_test.cpp
+
+DEFINES += "STYLES_DIR=$$PWD/../../styles"
+
+
+LIBS += -L$${ACSS_OUT_ROOT}/lib
+unix:QMAKE_RPATHDIR += $${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core widgets
+include(../../acss.pri)
+INCLUDEPATH += ../../src/core ../../src/widgets
+DEPENDPATH += ../../src/core ../../src/widgets
@@ -0,0 +1,184 @@
+#include <StyleProcessor.h>
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace acss;
+
+#define _STR(x) #x
+#define STRINGIFY(x)  _STR(x)
+
+/**
+ * Copies the directory Source recursively into Target
+ */
+static bool copyDirectory(const QString& Source, const QString& Target)
+{
+	QDir SourceDir(Source);
+	QDirIterator it(Source, QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext())
+	{
+		auto FilePath = it.next();
+		auto TargetPath = Target + "/" + SourceDir.relativeFilePath(FilePath);
+		if (!QDir().mkpath(QFileInfo(TargetPath).absolutePath())
+		 || !QFile::copy(FilePath, TargetPath))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Tests of the asynchronous operations and the state of CStyleProcessor
+ */
+class CStyleProcessorTest : public QObject
+{
+	Q_OBJECT
+private:
+	QTemporaryDir StylesDir;
+	QTemporaryDir OutputDir;
+	CStyleProcessor* Processor = nullptr;
+
+	/**
+	 * Processes events until no style open and no stylesheet update is
+	 * running anymore
+	 */
+	bool waitForIdle()
+	{
+		QElapsedTimer Timer;
+		Timer.start();
+		auto isRunning = [this]()
+		{
+			return Processor->isStyleOpenRunning() || Processor->isStylesheetUpdateRunning();
+		};
+		while (isRunning() && Timer.elapsed() < 20000)
+		{
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+		}
+		return !isRunning();
+	}
+
+private slots:
+	void initTestCase()
+	{
+		// Two styles, so that overlapping opens can be distinguished
+		for (const auto& Style : {"style_a", "style_b"})
+		{
+			QVERIFY(copyDirectory(QString(STRINGIFY(STYLES_DIR)) + "/qt_material",
+				StylesDir.path() + "/" + Style));
+		}
+	}
+
+	void init()
+	{
+		Processor = new CStyleProcessor();
+		Processor->setStylesDirPath(StylesDir.path());
+		Processor->setOutputDirPath(OutputDir.path());
+	}
+
+	void cleanup()
+	{
+		QVERIFY(waitForIdle());
+		delete Processor;
+		Processor = nullptr;
+	}
+
+	void overlappingOpensApplyTheLastStyle()
+	{
+		QSignalSpy StyleSpy(Processor, &CStyleProcessor::currentStyleChanged);
+		Processor->openStyle("style_a", "light_blue");
+		Processor->openStyle("style_b", "dark_teal");
+
+		// Update requests that arrive while the first open finished and the
+		// second one is still running must not cancel the second one
+		while (Processor->isStyleOpenRunning())
+		{
+			Processor->requestStylesheetUpdate();
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+		}
+		QVERIFY(waitForIdle());
+
+		QCOMPARE(Processor->currentStyle(), QString("style_b"));
+		QCOMPARE(Processor->currentTheme(), QString("dark_teal"));
+		QCOMPARE(StyleSpy.count(), 1);
+		QVERIFY(!Processor->styleSheet().isEmpty());
+	}
+
+	void staleGenerationIsDiscarded()
+	{
+		QVERIFY(Processor->setCurrentStyle("style_a"));
+		QVERIFY(Processor->setCurrentTheme("light_blue"));
+		QVERIFY(Processor->updateStylesheet());
+		auto Stylesheet = Processor->styleSheet();
+		QSignalSpy StylesheetSpy(Processor, &CStyleProcessor::stylesheetChanged);
+
+		// The theme change after the request starts a new epoch without a
+		// new update request, so the dark_teal generation is stale when it
+		// finishes
+		QVERIFY(Processor->setCurrentTheme("dark_teal"));
+		Processor->requestStylesheetUpdate();
+		QVERIFY(Processor->setCurrentTheme("light_blue"));
+		QVERIFY(waitForIdle());
+
+		QCOMPARE(Processor->styleSheet(), Stylesheet);
+		QCOMPARE(StylesheetSpy.count(), 0);
+	}
+
+	void overridesSurviveFileRoundTrip()
+	{
+		auto OverridesFilePath = OutputDir.path() + "/overrides.json";
+		QFile::remove(OverridesFilePath);
+		QVERIFY(Processor->setVariableOverridesFilePath(OverridesFilePath));
+		QVERIFY(Processor->setCurrentStyle("style_a"));
+		QVERIFY(Processor->setCurrentTheme("light_blue"));
+		auto ThemeValue = Processor->themeVariableValue("primaryColor");
+		QVERIFY(!ThemeValue.isEmpty());
+		Processor->setVariableOverride("primaryColor", "#123456");
+		QCOMPARE(Processor->themeVariableValue("primaryColor"), QString("#123456"));
+		QVERIFY(QFile::exists(OverridesFilePath));
+
+		// A new processor reads the override from the file and applies it
+		// each time the theme is loaded
+		{
+			CStyleProcessor Restarted;
+			Restarted.setStylesDirPath(StylesDir.path());
+			Restarted.setOutputDirPath(OutputDir.path());
+			QVERIFY(Restarted.setVariableOverridesFilePath(OverridesFilePath));
+			QVERIFY(Restarted.setCurrentStyle("style_a"));
+			QVERIFY(Restarted.setCurrentTheme("light_blue"));
+			QCOMPARE(Restarted.themeVariableValue("primaryColor"), QString("#123456"));
+			QVERIFY(Restarted.setCurrentTheme("dark_teal"));
+			QVERIFY(Restarted.variableOverrides().isEmpty());
+			QVERIFY(Restarted.themeVariableValue("primaryColor") != QString("#123456"));
+			QVERIFY(Restarted.setCurrentTheme("light_blue"));
+			QCOMPARE(Restarted.themeVariableValue("primaryColor"), QString("#123456"));
+		}
+
+		// The removal restores the value of the theme file and is persisted
+		Processor->removeVariableOverride("primaryColor");
+		QCOMPARE(Processor->themeVariableValue("primaryColor"), ThemeValue);
+		QVERIFY(Processor->variableOverrides().isEmpty());
+		{
+			CStyleProcessor Restarted;
+			Restarted.setStylesDirPath(StylesDir.path());
+			Restarted.setOutputDirPath(OutputDir.path());
+			QVERIFY(Restarted.setVariableOverridesFilePath(OverridesFilePath));
+			QVERIFY(Restarted.setCurrentStyle("style_a"));
+			QVERIFY(Restarted.setCurrentTheme("light_blue"));
+			QCOMPARE(Restarted.themeVariableValue("primaryColor"), ThemeValue);
+			QVERIFY(Restarted.variableOverrides().isEmpty());
+		}
+	}
+};
+
+
+QTEST_GUILESS_MAIN(CStyleProcessorTest)
+
+#include "style_processor_test.moc"
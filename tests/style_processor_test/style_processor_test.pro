@@ -0,0 +1,30 @@
+ACSS_OUT_ROOT = $${OUT_PWD}/../..
+
+QT = core testlib
+
+
+TARGET = style_processor_test
+DESTDIR = $${ACSS_OUT_ROOT}/lib
+TEMPLATE = app
+
+CONFIG += c++14
+CONFIG += console
+CONFIG += testcase
+
+acssBuildStatic {
+    DEFINES += ACSS_STATIC
+}
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += style_processor_test.cpp
+
+DEFINES += "STYLES_DIR=$$PWD/../../styles"
+
+
+LIBS += -L$${ACSS_OUT_ROOT}/lib
+unix:QMAKE_RPATHDIR += $${ACSS_OUT_ROOT}/lib
+ACSS_MODULES = core
+include(../../acss.pri)
+INCLUDEPATH += ../../src/core
+DEPENDPATH += ../../src/core
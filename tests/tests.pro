@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    palette_schema_test \
+    style_cache_test \
+    style_manager_test \
+    style_processor_test